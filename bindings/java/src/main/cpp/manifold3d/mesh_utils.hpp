@@ -779,4 +779,17 @@ manifold::Manifold Loft(const manifold::CrossSection section, const std::vector<
     return Loft(sections, transforms, algorithm);
 }
 
+
+// Batched level set for callers that cross a language boundary per call. The
+// sdf receives count packed xyz positions and writes count values.
+manifold::Manifold LevelSetBatch(void (*sdf)(const double* positions, double* values, std::size_t count),
+                                 const manifold::Box& bounds, double edgeLength, double level = 0,
+                                 double tolerance = -1, double lipschitz = 0) {
+    return manifold::Manifold::LevelSetBatch(
+        [sdf](manifold::VecView<const vec3> positions, manifold::VecView<double> values) {
+            sdf(&positions.data()->x, values.data(), positions.size());
+        },
+        bounds, edgeLength, level, tolerance, false, lipschitz);
+}
+
 }
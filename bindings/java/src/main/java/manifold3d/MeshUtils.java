@@ -15,6 +15,7 @@ import manifold3d.pub.SimplePolygon;
 import manifold3d.UIntVecVector;
 
 import manifold3d.Manifold;
+import manifold3d.pub.Box;
 import java.nio.DoubleBuffer;
 import java.nio.FloatBuffer;
 import java.nio.IntBuffer;
@@ -89,4 +90,33 @@ public class MeshUtils extends Pointer {
     public static native @ByVal Manifold Loft(@ByRef CrossSectionVector sections, @ByRef DoubleMat3x4Vector transforms, LoftAlgorithm algorithmEnum);
     public static native @ByVal Manifold Loft(@ByRef CrossSection section, @ByRef DoubleMat3x4Vector transforms);
     public static native @ByVal Manifold Loft(@ByRef CrossSection section, @ByRef DoubleMat3x4Vector transforms, LoftAlgorithm algorithmEnum);
+
+    public interface BatchSdfFunction {
+        // Fill values with the signed distance of each packed xyz position.
+        void apply(DoubleBuffer positions, DoubleBuffer values);
+    }
+
+    public static class BatchSdf extends FunctionPointer {
+        static { Loader.load(); }
+
+        private final BatchSdfFunction function;
+
+        public BatchSdf(BatchSdfFunction function) {
+            this.function = function;
+            allocate();
+        }
+        private native void allocate();
+
+        public void call(@Const DoublePointer positions, DoublePointer values, @Cast("std::size_t") long count) {
+            function.apply(positions.capacity(3 * count).asBuffer(), values.capacity(count).asBuffer());
+        }
+    }
+
+    public static native @ByVal Manifold LevelSetBatch(BatchSdf sdf, @Const @ByRef Box bounds, double edgeLength);
+    public static native @ByVal Manifold LevelSetBatch(BatchSdf sdf, @Const @ByRef Box bounds, double edgeLength, double level);
+    public static native @ByVal Manifold LevelSetBatch(BatchSdf sdf, @Const @ByRef Box bounds, double edgeLength, double level, double tolerance);
+    public static native @ByVal Manifold LevelSetBatch(BatchSdf sdf, @Const @ByRef Box bounds, double edgeLength, double level, double tolerance, double lipschitz);
+    public static Manifold LevelSetBatch(BatchSdfFunction sdf, Box bounds, double edgeLength, double level, double tolerance, double lipschitz) {
+        return LevelSetBatch(new BatchSdf(sdf), bounds, edgeLength, level, tolerance, lipschitz);
+    }
 }
@@ -230,6 +230,10 @@ NB_MODULE(manifold3d, m) {
       .def(
           "hull", [](const Manifold &self) { return self.Hull(); },
           manifold__hull)
+      .def("offset", &Manifold::Offset, nb::arg("delta"),
+           nb::arg("edge_length"), manifold__offset__delta__edge_length)
+      .def("shell", &Manifold::Shell, nb::arg("thickness"),
+           nb::arg("edge_length"), manifold__shell__thickness__edge_length)
       .def_static(
           "batch_hull",
           [](std::vector<Manifold> ms) { return Manifold::Hull(ms); },
@@ -315,10 +319,207 @@ NB_MODULE(manifold3d, m) {
       .def("calculate_curvature", &Manifold::CalculateCurvature,
            nb::arg("gaussian_idx"), nb::arg("mean_idx"),
            manifold__calculate_curvature__gaussian_idx__mean_idx)
-      .def("min_gap", &Manifold::MinGap, nb::arg("other"),
-           nb::arg("search_length"),
+      .def("min_gap",
+           nb::overload_cast<const Manifold &, double>(&Manifold::MinGap,
+                                                      nb::const_),
+           nb::arg("other"), nb::arg("search_length"),
            "Returns the minimum gap between two manifolds."
            "Returns a double between 0 and searchLength.")
+      .def("min_gap",
+           nb::overload_cast<const Manifold &, double, const mat3x4 &>(
+               &Manifold::MinGap, nb::const_),
+           nb::arg("other"), nb::arg("search_length"),
+           nb::arg("other_transform"),
+           manifold__min_gap__other__search_length__other_transform)
+      .def("overlaps",
+           nb::overload_cast<const Manifold &>(&Manifold::Overlaps,
+                                               nb::const_),
+           nb::arg("other"), manifold__overlaps__other)
+      .def("overlaps",
+           nb::overload_cast<const Manifold &, const mat3x4 &>(
+               &Manifold::Overlaps, nb::const_),
+           nb::arg("other"), nb::arg("other_transform"),
+           manifold__overlaps__other__other_transform)
+      .def_static(
+          "pairwise_overlaps",
+          [](std::vector<Manifold> manifolds, double clearance) {
+            const std::vector<Interference> result =
+                Manifold::PairwiseOverlaps(manifolds, clearance);
+            const size_t n = result.size();
+            int64_t *pairs = new int64_t[2 * n];
+            double *distance = new double[n];
+            for (size_t i = 0; i < n; ++i) {
+              pairs[2 * i] = result[i].first;
+              pairs[2 * i + 1] = result[i].second;
+              distance[i] = result[i].distance;
+            }
+            nb::capsule pairsOwner(
+                pairs, [](void *p) noexcept { delete[] (int64_t *)p; });
+            nb::capsule distanceOwner(
+                distance, [](void *p) noexcept { delete[] (double *)p; });
+            return nb::make_tuple(
+                nb::ndarray<nb::numpy, int64_t, nb::shape<-1, 2>>(
+                    pairs, {n, 2}, std::move(pairsOwner)),
+                nb::ndarray<nb::numpy, double, nb::shape<-1>>(
+                    distance, {n}, std::move(distanceOwner)));
+          },
+          nb::arg("manifolds"), nb::arg("clearance") = 0.0,
+          "Finds every pair of manifolds that overlap or are closer than "
+          "clearance, using a bounding-box broadphase so large assemblies "
+          "don't need a loop over all pairs. Returns a tuple of an Nx2 array "
+          "of indices, sorted with the first less than the second, and an "
+          "array of their gaps, which are 0 where they overlap.")
+      .def(
+          "signed_distance",
+          [](const Manifold &self,
+             nb::ndarray<const double, nb::shape<-1, 3>, nb::c_contig> points,
+             double maxDistance) {
+            const size_t n = points.shape(0);
+            double *buffer = new double[n];
+            nb::capsule mem_mgr(buffer,
+                                [](void *p) noexcept { delete[] (double *)p; });
+            self.SignedDistance(
+                VecView<const vec3>(
+                    reinterpret_cast<const vec3 *>(points.data()), n),
+                VecView<double>(buffer, n), maxDistance);
+            return nb::ndarray<nb::numpy, double, nb::shape<-1>>(
+                buffer, {n}, std::move(mem_mgr));
+          },
+          nb::arg("points"),
+          nb::arg("max_distance") = std::numeric_limits<double>::infinity(),
+          "Returns the signed distance from each point (an Nx3 array) to the "
+          "surface, positive inside and negative outside like the sdf of "
+          "level_set. Distances are clamped to +/- max_distance, which makes "
+          "queries faster when only a band around the surface matters.")
+      .def(
+          "ray_cast",
+          [](const Manifold &self,
+             nb::ndarray<const double, nb::shape<-1, 3>, nb::c_contig> origins,
+             nb::ndarray<const double, nb::shape<-1, 3>, nb::c_contig>
+                 directions) {
+            const size_t n = origins.shape(0);
+            if (directions.shape(0) != n)
+              throw std::runtime_error(
+                  "origins and directions must be the same length");
+            const std::vector<RayHit> hits = self.RayCast(
+                VecView<const vec3>(
+                    reinterpret_cast<const vec3 *>(origins.data()), n),
+                VecView<const vec3>(
+                    reinterpret_cast<const vec3 *>(directions.data()), n));
+            double *distance = new double[n];
+            double *normal = new double[3 * n];
+            double *barycentric = new double[3 * n];
+            int *originalID = new int[n];
+            int *faceID = new int[n];
+            for (size_t i = 0; i < n; ++i) {
+              distance[i] = hits[i].distance;
+              for (const int j : {0, 1, 2}) {
+                normal[3 * i + j] = hits[i].normal[j];
+                barycentric[3 * i + j] = hits[i].barycentric[j];
+              }
+              originalID[i] = hits[i].originalID;
+              faceID[i] = hits[i].faceID;
+            }
+            auto owner = [](double *p) {
+              return nb::capsule(
+                  p, [](void *p) noexcept { delete[] (double *)p; });
+            };
+            auto intOwner = [](int *p) {
+              return nb::capsule(p,
+                                 [](void *p) noexcept { delete[] (int *)p; });
+            };
+            return nb::make_tuple(
+                nb::ndarray<nb::numpy, double, nb::shape<-1>>(
+                    distance, {n}, owner(distance)),
+                nb::ndarray<nb::numpy, double, nb::shape<-1, 3>>(
+                    normal, {n, 3}, owner(normal)),
+                nb::ndarray<nb::numpy, double, nb::shape<-1, 3>>(
+                    barycentric, {n, 3}, owner(barycentric)),
+                nb::ndarray<nb::numpy, int, nb::shape<-1>>(
+                    originalID, {n}, intOwner(originalID)),
+                nb::ndarray<nb::numpy, int, nb::shape<-1>>(faceID, {n},
+                                                           intOwner(faceID)));
+          },
+          nb::arg("origins"), nb::arg("directions"),
+          "Casts rays given by Nx3 arrays of origins and directions, and "
+          "returns the first hit of each beyond its origin as a tuple of "
+          "arrays: distance (infinity on a miss, in units of the direction's "
+          "length), normal, barycentric, original_id and face_id (-1 on a "
+          "miss). The ids match run_original_id and face_id of to_mesh(); "
+          "the triangle index itself is not returned.")
+      .def(
+          "contains",
+          [](const Manifold &self,
+             nb::ndarray<const double, nb::shape<-1, 3>, nb::c_contig> points) {
+            const size_t n = points.shape(0);
+            const std::vector<Containment> result =
+                self.Contains(VecView<const vec3>(
+                    reinterpret_cast<const vec3 *>(points.data()), n));
+            int8_t *buffer = new int8_t[n];
+            nb::capsule mem_mgr(
+                buffer, [](void *p) noexcept { delete[] (int8_t *)p; });
+            for (size_t i = 0; i < n; ++i) {
+              buffer[i] = result[i] == Containment::Inside    ? 1
+                          : result[i] == Containment::Outside ? -1
+                                                              : 0;
+            }
+            return nb::ndarray<nb::numpy, int8_t, nb::shape<-1>>(
+                buffer, {n}, std::move(mem_mgr));
+          },
+          nb::arg("points"),
+          "Classifies each point of an Nx3 array, returning 1 inside, -1 "
+          "outside and 0 within the tolerance of the surface.")
+      .def(
+          "closest_points",
+          [](const Manifold &self,
+             nb::ndarray<const double, nb::shape<-1, 3>, nb::c_contig> points,
+             double maxDistance) {
+            const size_t n = points.shape(0);
+            const std::vector<SurfacePoint> closest = self.ClosestPoints(
+                VecView<const vec3>(
+                    reinterpret_cast<const vec3 *>(points.data()), n),
+                maxDistance);
+            double *distance = new double[n];
+            double *position = new double[3 * n];
+            double *normal = new double[3 * n];
+            int *originalID = new int[n];
+            int *faceID = new int[n];
+            for (size_t i = 0; i < n; ++i) {
+              distance[i] = closest[i].distance;
+              for (const int j : {0, 1, 2}) {
+                position[3 * i + j] = closest[i].position[j];
+                normal[3 * i + j] = closest[i].normal[j];
+              }
+              originalID[i] = closest[i].originalID;
+              faceID[i] = closest[i].faceID;
+            }
+            auto owner = [](double *p) {
+              return nb::capsule(
+                  p, [](void *p) noexcept { delete[] (double *)p; });
+            };
+            auto intOwner = [](int *p) {
+              return nb::capsule(p,
+                                 [](void *p) noexcept { delete[] (int *)p; });
+            };
+            return nb::make_tuple(
+                nb::ndarray<nb::numpy, double, nb::shape<-1>>(
+                    distance, {n}, owner(distance)),
+                nb::ndarray<nb::numpy, double, nb::shape<-1, 3>>(
+                    position, {n, 3}, owner(position)),
+                nb::ndarray<nb::numpy, double, nb::shape<-1, 3>>(
+                    normal, {n, 3}, owner(normal)),
+                nb::ndarray<nb::numpy, int, nb::shape<-1>>(
+                    originalID, {n}, intOwner(originalID)),
+                nb::ndarray<nb::numpy, int, nb::shape<-1>>(faceID, {n},
+                                                           intOwner(faceID)));
+          },
+          nb::arg("points"),
+          nb::arg("max_distance") = std::numeric_limits<double>::infinity(),
+          "Finds the nearest surface point to each point of an Nx3 array, "
+          "returning a tuple of arrays: distance (infinity if none within "
+          "max_distance), position, normal, original_id and face_id (-1 if "
+          "none). The ids match run_original_id and face_id of to_mesh(); "
+          "the triangle index itself is not returned.")
       .def("calculate_normals", &Manifold::CalculateNormals,
            nb::arg("normal_idx"), nb::arg("min_sharp_angle") = 60,
            manifold__calculate_normals__normal_idx__min_sharp_angle)
@@ -459,7 +660,7 @@ NB_MODULE(manifold3d, m) {
           "level_set",
           [](const std::function<double(double, double, double)> &f,
              std::vector<double> bounds, double edgeLength, double level = 0.0,
-             double tolerance = -1) {
+             double tolerance = -1, double lipschitz = 0, int tileSize = 0) {
             // Same format as Manifold.bounding_box
             Box bound = {vec3(bounds[0], bounds[1], bounds[2]),
                          vec3(bounds[3], bounds[4], bounds[5])};
@@ -468,11 +669,43 @@ NB_MODULE(manifold3d, m) {
               return f(v.x, v.y, v.z);
             };
             return Manifold::LevelSet(cppToPython, bound, edgeLength, level,
-                                      tolerance, false);
+                                      tolerance, false, lipschitz, tileSize);
+          },
+          nb::arg("f"), nb::arg("bounds"), nb::arg("edgeLength"),
+          nb::arg("level") = 0.0, nb::arg("tolerance") = -1,
+          nb::arg("lipschitz") = 0, nb::arg("tile_size") = 0,
+          manifold__level_set__sdf__bounds__edge_length__level__tolerance__can_parallel__lipschitz__tile_size)
+      .def_static(
+          "level_set_batch",
+          [](const std::function<nb::object(
+                 nb::ndarray<nb::numpy, const double, nb::shape<-1, 3>>)> &f,
+             std::vector<double> bounds, double edgeLength, double level = 0.0,
+             double tolerance = -1, double lipschitz = 0, int tileSize = 0) {
+            // Same format as Manifold.bounding_box
+            Box bound = {vec3(bounds[0], bounds[1], bounds[2]),
+                         vec3(bounds[3], bounds[4], bounds[5])};
+
+            auto cppToPython = [&f](VecView<const vec3> positions,
+                                    VecView<double> values) {
+              auto result =
+                  f(nb::ndarray<nb::numpy, const double, nb::shape<-1, 3>>(
+                      &positions.data()->x, {positions.size(), 3},
+                      nb::handle()));
+              nb::ndarray<double, nb::shape<-1>> array;
+              if (!nb::try_cast(result, array) ||
+                  array.shape(0) != values.size())
+                throw std::runtime_error("Invalid vector shape, expected (" +
+                                         std::to_string(values.size()) + ")");
+              for (size_t i = 0; i < values.size(); i++) values[i] = array(i);
+            };
+            return Manifold::LevelSetBatch(cppToPython, bound, edgeLength,
+                                           level, tolerance, false, lipschitz,
+                                           tileSize);
           },
           nb::arg("f"), nb::arg("bounds"), nb::arg("edgeLength"),
           nb::arg("level") = 0.0, nb::arg("tolerance") = -1,
-          manifold__level_set__sdf__bounds__edge_length__level__tolerance__can_parallel)
+          nb::arg("lipschitz") = 0, nb::arg("tile_size") = 0,
+          manifold__level_set_batch__sdf__bounds__edge_length__level__tolerance__can_parallel__lipschitz__tile_size)
       .def_static(
           "cylinder", &Manifold::Cylinder, nb::arg("height"),
           nb::arg("radius_low"), nb::arg("radius_high") = -1.0f,
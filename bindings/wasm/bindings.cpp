@@ -22,15 +22,16 @@
 #include "manifold/manifold.h"
 #include "manifold/polygon.h"
 
-#if (MANIFOLD_PAR == 1)
+#if (MANIFOLD_PAR == 1) && !defined(MANIFOLD_PAR_NATIVE)
 #include <tbb/parallel_for.h>
 
 #include <atomic>
 #endif
 
 // https://github.com/oneapi-src/oneTBB/blob/master/WASM_Support.md#limitations
+// The native backend needs no warmup, as waiting threads run tasks themselves.
 void initTBB() {
-#if (MANIFOLD_PAR == 1)
+#if (MANIFOLD_PAR == 1) && !defined(MANIFOLD_PAR_NATIVE)
   int num_threads = tbb::this_task_arena::max_concurrency();
   std::atomic<int> barrier{num_threads};
   tbb::parallel_for(
@@ -186,7 +187,9 @@ EMSCRIPTEN_BINDINGS(whatever) {
       .function("genus", &Manifold::Genus)
       .function("volume", &Manifold::Volume)
       .function("surfaceArea", &Manifold::SurfaceArea)
-      .function("minGap", &Manifold::MinGap)
+      .function("minGap",
+                select_overload<double(const Manifold&, double) const>(
+                    &Manifold::MinGap))
       .function("calculateCurvature", &Manifold::CalculateCurvature)
       .function("_CalculateNormals", &Manifold::CalculateNormals)
       .function("originalID", &Manifold::OriginalID)
@@ -61,7 +61,7 @@ endif()
 message(STATUS "BUILD_SHARED_LIBS:             ${BUILD_SHARED_LIBS}")
 message(STATUS " ")
 message(STATUS "MANIFOLD_VERSION:              ${MANIFOLD_VERSION}")
-message(STATUS "MANIFOLD_PAR:                  ${MANIFOLD_PAR}")
+message(STATUS "MANIFOLD_PAR:                  ${MANIFOLD_PAR_BACKEND}")
 message(STATUS "MANIFOLD_CROSS_SECTION:        ${MANIFOLD_CROSS_SECTION}")
 message(STATUS "MANIFOLD_EXPORT:               ${MANIFOLD_EXPORT}")
 message(STATUS "MANIFOLD_TEST:                 ${MANIFOLD_TEST}")
@@ -37,9 +37,12 @@ set(OLD_BUILD_SHARED_LIBS ${BUILD_SHARED_LIBS})
 # we build fetched dependencies as static library
 set(BUILD_SHARED_LIBS OFF)
 
-# If we're building parallel, we need tbb
 if(MANIFOLD_PAR)
   find_package(Threads REQUIRED)
+endif()
+
+# If we're building parallel with the TBB backend, we need tbb
+if(MANIFOLD_PAR_BACKEND STREQUAL "TBB")
   if(NOT MANIFOLD_USE_BUILTIN_TBB)
     find_package(TBB QUIET)
     find_package(PkgConfig QUIET)
@@ -0,0 +1,100 @@
+// Copyright 2026 The Manifold Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "manifold/manifold.h"
+
+using namespace manifold;
+
+// Cubic lattice of cylindrical struts, which overlap at every node.
+std::vector<Manifold> Lattice(int n) {
+  const Manifold strut = Manifold::Cylinder(n, 0.15, 0.15, 16);
+  std::vector<Manifold> parts;
+  for (int i = 0; i <= n; ++i) {
+    for (int j = 0; j <= n; ++j) {
+      parts.push_back(strut.Translate(vec3(i, j, 0)));
+      parts.push_back(strut.Rotate(90).Translate(vec3(i, n, j)));
+      parts.push_back(strut.Rotate(0, 90).Translate(vec3(0, i, j)));
+    }
+  }
+  return parts;
+}
+
+// Large plates drilled with many holes that only touch along their edges,
+// fastened by small bolts that heavily overlap each other.
+std::vector<Manifold> DrilledPlates(int n) {
+  Manifold plate = Manifold::Cube({10, 10, 1});
+  std::vector<Manifold> holes;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      holes.push_back(Manifold::Cylinder(3, 0.2, 0.2, 32).Translate(
+          vec3(10.0 * (i + 0.5) / n, 10.0 * (j + 0.5) / n, -1)));
+    }
+  }
+  plate -= Manifold::Compose(holes);
+  std::vector<Manifold> parts;
+  for (int i = 0; i < 4; ++i) {
+    parts.push_back(plate.Translate(vec3(9.9 * i, 0, 0)));
+  }
+  for (int i = 0; i < 3; ++i) {
+    const vec3 pos(9.9 * i + 10, 5, -1);
+    parts.push_back(Manifold::Cylinder(3, 0.5, 0.5, 64).Translate(pos));
+    parts.push_back(Manifold::Sphere(0.8, 64).Translate(pos + vec3(0, 0, 3)));
+    parts.push_back(Manifold::Cylinder(0.5, 0.9, 0.9, 6).Translate(pos));
+  }
+  return parts;
+}
+
+void Run(const std::string& name, const std::vector<Manifold>& parts,
+         OpType op) {
+  for (BatchOrder order : {BatchOrder::VertexCount, BatchOrder::CostModel}) {
+    ManifoldParams().batchOrder = order;
+    auto start = std::chrono::high_resolution_clock::now();
+    Manifold result = Manifold::BatchBoolean(parts, op);
+    result.NumTri();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    std::cout << name << ", "
+              << (order == BatchOrder::CostModel ? "cost model"
+                                                 : "vertex count")
+              << ": nTri = " << result.NumTri()
+              << ", time = " << elapsed.count() << " sec" << std::endl;
+  }
+  ManifoldParams().batchOrder = BatchOrder::VertexCount;
+}
+
+/*
+  Compares the pairing order of BatchBoolean by vertex count against the
+  overlap-based cost model. Build & execute with the following command:
+
+  ( mkdir -p build && cd build && \
+    cmake -DCMAKE_BUILD_TYPE=Release -DMANIFOLD_PAR=ON .. && \
+    make -j && \
+    ./extras/batchOrderTest 8 )
+*/
+int main(int argc, char** argv) {
+  int n = 6;
+  if (argc == 2) n = atoi(argv[1]);
+
+  const std::vector<Manifold> lattice = Lattice(n);
+  Run("lattice", lattice, OpType::Add);
+  const std::vector<Manifold> plates = DrilledPlates(4 * n);
+  Run("drilled plates", plates, OpType::Add);
+  Run("drilled plates intersection", {plates[0], plates[1], plates[4]},
+      OpType::Intersect);
+}
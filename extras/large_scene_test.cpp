@@ -13,23 +13,55 @@
 // limitations under the License.
 
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 #include "manifold/manifold.h"
 
 using namespace manifold;
 
+// Union of many small parts in a single BatchBoolean: a grid of cubes, where
+// every tenth one is bridged to its neighbor by a bar, so the parts are mostly
+// disjoint but with some overlaps, like fasteners in an assembly.
+void BatchUnionScaling(int maxParts) {
+  const Manifold cube = Manifold::Cube(vec3(0.6), true);
+  const Manifold bar = Manifold::Cube({1.2, 0.2, 0.2}, true);
+  for (int numParts = 1000; numParts <= maxParts; numParts *= 10) {
+    const int side = std::ceil(std::sqrt(numParts));
+    std::vector<Manifold> parts;
+    for (int i = 0; i < numParts; ++i) {
+      const vec3 pos(i % side, i / side, 0);
+      parts.push_back(cube.Translate(pos));
+      if (i % 10 == 0) parts.push_back(bar.Translate(pos + vec3(0.5, 0, 0)));
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    Manifold scene = Manifold::BatchBoolean(parts, OpType::Add);
+    scene.NumTri();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    std::cout << "nParts = " << parts.size() << ", nTri = " << scene.NumTri()
+              << ", time = " << elapsed.count() << " sec" << std::endl;
+  }
+}
+
 /*
   Build & execute with the following command:
 
   ( mkdir -p build && cd build && \
     cmake -DCMAKE_BUILD_TYPE=Release -DMANIFOLD_PAR=ON .. && \
     make -j && \
-    time ./extras/largeSceneTest 50 )
+    time ./extras/largeSceneTest 50 100000 )
+
+  The optional second argument is the largest number of parts for the batch
+  union scaling test, which runs for 1k, 10k, ... parts up to this limit.
 */
 int main(int argc, char **argv) {
   int n = 20;
-  if (argc == 2) n = atoi(argv[1]);
+  int maxParts = 0;
+  if (argc >= 2) n = atoi(argv[1]);
+  if (argc >= 3) maxParts = atoi(argv[2]);
 
   std::cout << "n = " << n << std::endl;
 
@@ -51,4 +83,6 @@ int main(int argc, char **argv) {
   std::chrono::duration<double> elapsed = end - start;
   std::cout << "nTri = " << scene.NumTri() << ", time = " << elapsed.count()
             << " sec" << std::endl;
+
+  BatchUnionScaling(maxParts);
 }
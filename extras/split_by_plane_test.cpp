@@ -0,0 +1,69 @@
+// Copyright 2026 The Manifold Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "manifold/manifold.h"
+
+using namespace manifold;
+
+void Time(const std::string& name, int numTri,
+          const std::function<std::pair<Manifold, Manifold>()>& split) {
+  auto start = std::chrono::high_resolution_clock::now();
+  const std::pair<Manifold, Manifold> halves = split();
+  halves.first.NumTri();
+  halves.second.NumTri();
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end - start;
+  std::cout << name << ": nTri = " << numTri << ", time = " << elapsed.count()
+            << " sec" << std::endl;
+}
+
+/*
+  Compares SplitByPlane against a Boolean Split by a half-space and against
+  two TrimByPlane calls, which classify the mesh against the plane twice.
+  Build & execute with the following command:
+
+  ( mkdir -p build && cd build && \
+    cmake -DCMAKE_BUILD_TYPE=Release -DMANIFOLD_PAR=ON .. && \
+    make -j && \
+    ./extras/splitByPlaneTest )
+*/
+int main(int argc, char** argv) {
+  for (int i = 0; i < 6; ++i) {
+    const Manifold sphere =
+        Manifold::Sphere(1, (8 << i) * 4)
+            .SetProperties(3, [](double* newProp, vec3 pos, const double*) {
+              for (const int j : {0, 1, 2}) newProp[j] = pos[j];
+            });
+    const vec3 normal(1, 2, 3);
+    const double offset = 0.1;
+    const int numTri = sphere.NumTri();
+    const mat3 rotation =
+        la::qmat(la::rotation_quat(vec3(0, 0, 1), la::normalize(normal)));
+    const Manifold halfSpace = Manifold::Cube(vec3(4), true)
+                                   .Translate(vec3(0, 0, 2 + offset))
+                                   .Transform(mat3x4(rotation, vec3(0.0)));
+    Time("boolean split", numTri, [&]() { return sphere.Split(halfSpace); });
+    Time("two trims", numTri, [&]() {
+      return std::make_pair(sphere.TrimByPlane(normal, offset),
+                            sphere.TrimByPlane(-normal, -offset));
+    });
+    Time("split by plane", numTri,
+         [&]() { return sphere.SplitByPlane(normal, offset); });
+  }
+}
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #ifdef MANIFOLD_DEBUG
@@ -472,6 +474,27 @@ struct Rect {
  */
 enum class OpType { Add, Subtract, Intersect };
 
+/**
+ * @brief How a sampled volume is interpolated between its samples, see
+ * Manifold::LevelSet.
+ */
+enum class Interpolation { Trilinear, Tricubic };
+
+/**
+ * @brief The order in which a batch of Boolean operands is combined
+ * pairwise, see ExecutionParams::batchOrder.
+ */
+enum class BatchOrder {
+  /// Combine the meshes with the most vertices first, ignoring overlap.
+  VertexCount,
+  /// Greedily combine the pair with the lowest estimated cost first, based on
+  /// the overlap of their bounding boxes and the number of triangle pairs
+  /// within it, or on ExecutionParams::batchCost if set. Since the cost of
+  /// every pair is evaluated, batches of more than 256 operands fall back to
+  /// VertexCount.
+  CostModel,
+};
+
 constexpr int DEFAULT_SEGMENTS = 0;
 constexpr double DEFAULT_ANGLE = 10.0;
 constexpr double DEFAULT_LENGTH = 1.0;
@@ -562,6 +585,26 @@ class Quality {
     circularEdgeLength_ = DEFAULT_LENGTH;
   }
 };
+
+/**
+ * @brief An interface through which a host application supplies the threads
+ * that run the library's parallel work, see SetExecutor().
+ *
+ * The thread that calls into the library also runs queued work until its
+ * operation is done, so no job ever waits on another, and an executor may run
+ * jobs in any order, at any later time, or even immediately inside Submit().
+ */
+class Executor {
+ public:
+  virtual ~Executor() = default;
+
+  /// Number of jobs the executor can run at once, not counting the thread
+  /// that calls into the library.
+  virtual size_t Concurrency() const = 0;
+
+  /// Schedules job to be run once on one of the executor's threads.
+  virtual void Submit(std::function<void()> job) = 0;
+};
 /** @} */
 
 /** @addtogroup Debug
@@ -569,9 +612,12 @@ class Quality {
  * @{
  */
 
+class Manifold;
+
 /**
- * @brief Global parameters that control debugging output. Only has an
- * effect when compiled with the MANIFOLD_DEBUG flag.
+ * @brief Global parameters that control debugging output, which only have an
+ * effect when compiled with the MANIFOLD_DEBUG flag, along with a few that
+ * control Boolean evaluation in every build, as noted on each.
  */
 struct ExecutionParams {
   /// Perform extra sanity checks and assertions on the intermediate data
@@ -588,6 +634,38 @@ struct ExecutionParams {
   bool suppressErrors = false;
   /// Perform optional but recommended triangle cleanups in SimplifyTopology()
   bool cleanupTriangles = true;
+  /// Memory ceiling in bytes of the cache of Boolean results, keyed on the
+  /// content of both operands, which counts the operands each result keeps
+  /// alive. Zero (the default) disables the cache. Lowering it evicts the least
+  /// recently used results at the next Boolean or GetBooleanCacheStats().
+  /// Applies in every build.
+  size_t booleanCacheSize = 0;
+  /// The order in which BatchBoolean and the CSG tree combine the operands of
+  /// a union or intersection. Applies in every build.
+  BatchOrder batchOrder = BatchOrder::VertexCount;
+  /// Replaces the built-in estimate of the cost of a Boolean between two
+  /// operands when batchOrder is CostModel. It is called for every pair of
+  /// operands, possibly concurrently from several threads, so it must be
+  /// thread-safe and should be cheap compared to the Boolean. Applies in every
+  /// build.
+  std::function<double(const Manifold&, const Manifold&)> batchCost;
+};
+
+/**
+ * @brief Counters of the Boolean result cache, see
+ * ExecutionParams::booleanCacheSize.
+ */
+struct BooleanCacheStats {
+  /// Number of Booleans whose result was found in the cache.
+  size_t hits = 0;
+  /// Number of Booleans that were computed while the cache was enabled.
+  size_t misses = 0;
+  /// Number of results dropped to stay under the memory ceiling.
+  size_t evictions = 0;
+  /// Number of results currently in the cache.
+  size_t entries = 0;
+  /// Estimated memory in bytes held by the cached results.
+  size_t memory = 0;
 };
 /** @} */
 
@@ -30,8 +30,42 @@ namespace manifold {
  */
 ExecutionParams& ManifoldParams();
 
+/**
+ * @ingroup Debug
+ *
+ * Returns the counters of the Boolean result cache, which is enabled by
+ * setting ExecutionParams::booleanCacheSize.
+ *
+ * @return BooleanCacheStats
+ */
+BooleanCacheStats GetBooleanCacheStats();
+
+/**
+ * @ingroup Debug
+ *
+ * Removes all results from the Boolean cache and resets its counters.
+ */
+void ClearBooleanCache();
+
+/**
+ * Runs all parallel work, including calls to user callbacks such as level set
+ * and Warp functions, on the threads of executor instead of the library's own
+ * workers, or restores them if executor is null. Only has an effect with the
+ * native parallel backend (MANIFOLD_PAR=NATIVE).
+ *
+ * This is not thread-safe: it must not be called while any manifold work is
+ * running on another thread, as it stops and starts the library's workers and
+ * the executor is read without synchronization when work is queued. Since
+ * Manifolds are evaluated lazily, force any pending evaluation, e.g. with
+ * Status(), before removing an executor that it should have used.
+ *
+ * @param executor The host application's executor, or null.
+ */
+void SetExecutor(std::shared_ptr<Executor> executor);
+
 class CsgNode;
 class CsgLeafNode;
+class SDF;
 
 /** @addtogroup Core
  *  @brief The central classes of the library
@@ -168,6 +202,78 @@ using MeshGL = MeshGLP<float>;
  */
 using MeshGL64 = MeshGLP<double, uint64_t>;
 
+/**
+ * @brief The point on the surface of a Manifold nearest to a query, as
+ * returned by Manifold::ClosestPoints.
+ *
+ * Only two fields identify the triangle: originalID and faceID, the same
+ * values GetMeshGL() reports for it. The triangle's index and its mesh
+ * instance are not returned, because GetMeshGL() may reorder triangles.
+ */
+struct SurfacePoint {
+  /// The distance from the query to position. Infinity if no surface was
+  /// within the search distance.
+  double distance = std::numeric_limits<double>::infinity();
+  /// The nearest point on the surface.
+  vec3 position = vec3(0.0);
+  /// The outward unit normal of the triangle containing position.
+  vec3 normal = vec3(0.0);
+  /// The OriginalID of the mesh that triangle came from, as in
+  /// MeshGL::runOriginalID, or -1 if none was found.
+  int originalID = -1;
+  /// The faceID of that triangle, as in MeshGL::faceID, or -1 if none was
+  /// found.
+  int faceID = -1;
+};
+
+/**
+ * @brief Where a point lies relative to a Manifold, as returned by
+ * Manifold::Contains.
+ */
+enum class Containment {
+  Outside,
+  Inside,
+  /// Within the Manifold's tolerance of its surface.
+  Surface,
+};
+
+/**
+ * @brief The first intersection of a ray with a Manifold, as returned by
+ * Manifold::RayCast.
+ *
+ * As with SurfacePoint, only originalID and faceID identify the hit triangle.
+ * The triangle's index and its mesh instance are not returned.
+ */
+struct RayHit {
+  /// The hit is at origin + distance * direction, so this is in units of the
+  /// direction's length. Infinity if the ray missed.
+  double distance = std::numeric_limits<double>::infinity();
+  /// The outward unit normal of the hit triangle.
+  vec3 normal = vec3(0.0);
+  /// The weights of the hit triangle's three verts at the hit point. For a
+  /// Manifold made directly from a MeshGL without faceIDs, these correspond to
+  /// the verts of triVerts[faceID], in order.
+  vec3 barycentric = vec3(0.0);
+  /// The OriginalID of the mesh the hit triangle came from, as in
+  /// MeshGL::runOriginalID, or -1 if the ray missed.
+  int originalID = -1;
+  /// The faceID of the hit triangle, as in MeshGL::faceID, or -1 if the ray
+  /// missed.
+  int faceID = -1;
+};
+
+/**
+ * @brief A pair of Manifolds that overlap or are closer than the clearance, as
+ * returned by Manifold::PairwiseOverlaps.
+ */
+struct Interference {
+  /// The indices of the pair in the input vector, with first < second.
+  size_t first = 0;
+  size_t second = 0;
+  /// The gap between the pair, which is 0 if they overlap.
+  double distance = 0;
+};
+
 /**
  * @brief This library's internal representation of an oriented, 2-manifold,
  * triangle mesh - a simple boundary-representation of a solid object. Use this
@@ -229,7 +335,21 @@ class Manifold {
   static Manifold Sphere(double radius, int circularSegments = 0);
   static Manifold LevelSet(std::function<double(vec3)> sdf, Box bounds,
                            double edgeLength, double level = 0,
-                           double tolerance = -1, bool canParallel = true);
+                           double tolerance = -1, bool canParallel = true,
+                           double lipschitz = 0, int tileSize = 0);
+  static Manifold LevelSetBatch(
+      std::function<void(VecView<const vec3>, VecView<double>)> sdf,
+      Box bounds, double edgeLength, double level = 0, double tolerance = -1,
+      bool canParallel = true, double lipschitz = 0, int tileSize = 0);
+  static Manifold LevelSet(const SDF& sdf, Box bounds, double edgeLength,
+                           double level = 0, double tolerance = -1,
+                           bool canParallel = true, int tileSize = 0);
+  static Manifold LevelSet(VecView<const float> samples, ivec3 dims,
+                           vec3 spacing, vec3 origin = vec3(0.0),
+                           double level = 0,
+                           Interpolation interp = Interpolation::Trilinear,
+                           double tolerance = -1, bool canParallel = true,
+                           int tileSize = 0);
   ///@}
 
   /** @name Polygons
@@ -238,6 +358,9 @@ class Manifold {
   ///@{
   Polygons Slice(double height = 0) const;
   std::vector<Polygons> Slices(double bottomZ, double topZ, int nSlices) const;
+  void SliceStream(double bottomZ, double topZ, int nSlices,
+                   std::function<void(int, Polygons)> callback,
+                   bool ordered = true) const;
   Polygons Project() const;
   static Manifold Extrude(const Polygons& crossSection, double height,
                           int nDivisions = 0, double twistDegrees = 0.0,
@@ -290,6 +413,24 @@ class Manifold {
   double SurfaceArea() const;
   double Volume() const;
   double MinGap(const Manifold& other, double searchLength) const;
+  double MinGap(const Manifold& other, double searchLength,
+                const mat3x4& otherTransform) const;
+  bool Overlaps(const Manifold& other) const;
+  bool Overlaps(const Manifold& other, const mat3x4& otherTransform) const;
+  static std::vector<Interference> PairwiseOverlaps(
+      const std::vector<Manifold>& manifolds, double clearance = 0);
+  double SignedDistance(
+      vec3 point,
+      double maxDistance = std::numeric_limits<double>::infinity()) const;
+  void SignedDistance(
+      VecView<const vec3> points, VecView<double> distances,
+      double maxDistance = std::numeric_limits<double>::infinity()) const;
+  std::vector<RayHit> RayCast(VecView<const vec3> origins,
+                              VecView<const vec3> directions) const;
+  std::vector<Containment> Contains(VecView<const vec3> points) const;
+  std::vector<SurfacePoint> ClosestPoints(
+      VecView<const vec3> points,
+      double maxDistance = std::numeric_limits<double>::infinity()) const;
   ///@}
 
   /** @name Mesh ID
@@ -371,6 +512,14 @@ class Manifold {
   static Manifold Hull(const std::vector<vec3>& pts);
   ///@}
 
+  /** @name Offset
+   * Grow, shrink or hollow by re-meshing the signed distance to the surface.
+   */
+  ///@{
+  Manifold Offset(double delta, double edgeLength) const;
+  Manifold Shell(double thickness, double edgeLength) const;
+  ///@}
+
   /** @name Testing Hooks
    *  These are just for internal testing.
    */
@@ -378,6 +527,8 @@ class Manifold {
   bool MatchesTriNormals() const;
   size_t NumDegenerateTris() const;
   size_t NumOverlaps(const Manifold& second) const;
+  size_t NumOverlaps(const Manifold& second,
+                     const mat3x4& secondTransform) const;
   double GetEpsilon() const;
   ///@}
 
@@ -388,6 +539,7 @@ class Manifold {
 #endif
 
  private:
+  friend class CsgLeafNode;
   Manifold(std::shared_ptr<CsgNode> pNode_);
   Manifold(std::shared_ptr<Impl> pImpl_);
   static Manifold Invalid();
@@ -0,0 +1,81 @@
+// Copyright 2026 The Manifold Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+
+#include "manifold/common.h"
+#include "manifold/vec_view.h"
+
+namespace manifold {
+
+class SdfNode;
+
+/** @addtogroup Core
+ *  @{
+ */
+
+/**
+ * @brief An immutable expression for a signed-distance function, built from
+ * primitives and operations. Like Manifold::LevelSet's sdf, values are positive
+ * inside and negative outside. Unlike an opaque function, it is evaluated
+ * natively over blocks of points, and can bound its values over a whole box
+ * with interval arithmetic, which lets Manifold::LevelSet skip regions that are
+ * entirely inside or outside without sampling them.
+ */
+class SDF {
+ public:
+  /** @name Primitives
+   *  All are centered on the origin.
+   */
+  ///@{
+  static SDF Sphere(double radius);
+  static SDF Cube(vec3 size);
+  static SDF Cylinder(double height, double radius);
+  static SDF Gyroid(double period);
+  static SDF Plane(vec3 normal, double originOffset = 0);
+  ///@}
+
+  /** @name Operations
+   */
+  ///@{
+  SDF operator+(const SDF&) const;
+  SDF operator-(const SDF&) const;
+  SDF operator^(const SDF&) const;
+  SDF SmoothUnion(const SDF&, double radius) const;
+  SDF SmoothIntersection(const SDF&, double radius) const;
+  SDF SmoothDifference(const SDF&, double radius) const;
+  SDF Offset(double distance) const;
+  SDF Shell(double thickness) const;
+  SDF Translate(vec3) const;
+  SDF Rotate(double xDegrees, double yDegrees = 0.0,
+             double zDegrees = 0.0) const;
+  SDF Scale(double) const;
+  SDF Transform(const mat3x4&) const;
+  ///@}
+
+  /** @name Evaluation
+   */
+  ///@{
+  double operator()(vec3 point) const;
+  void Evaluate(VecView<const vec3> points, VecView<double> values) const;
+  vec2 Bound(const Box& box) const;
+  ///@}
+
+ private:
+  SDF(std::shared_ptr<const SdfNode> node);
+  std::shared_ptr<const SdfNode> node_;
+};
+/** @} */
+}  // namespace manifold
@@ -13,18 +13,12 @@
 // limitations under the License.
 
 #include "manifold/manifold.h"
+#include "manifold/sdf.h"
 #include "samples.h"
 
 namespace {
 using namespace manifold;
 
-struct Gyroid {
-  double operator()(vec3 p) const {
-    p -= kPi / 4;
-    return cos(p.x) * sin(p.y) + cos(p.y) * sin(p.z) + cos(p.z) * sin(p.x);
-  }
-};
-
 Manifold RhombicDodecahedron(double size) {
   Manifold box = Manifold::Cube(size * la::sqrt(2.0) * vec3(1, 1, 2), true);
   Manifold result = box.Rotate(90, 45) ^ box.Rotate(90, 45, 90);
@@ -49,7 +43,8 @@ namespace manifold {
 Manifold GyroidModule(double size, int n) {
   auto gyroid = [&](double level) {
     const double period = kTwoPi;
-    return Manifold::LevelSet(Gyroid(), {vec3(-period), vec3(period)},
+    const SDF gyroid = SDF::Gyroid(period).Translate(vec3(kPi / 4));
+    return Manifold::LevelSet(gyroid, {vec3(-period), vec3(period)},
                               period / n, level)
         .Scale(vec3(size / period));
   };
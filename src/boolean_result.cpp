@@ -20,7 +20,10 @@
 #include "./parallel.h"
 #include "./utils.h"
 
-#if (MANIFOLD_PAR == 1) && __has_include(<tbb/concurrent_map.h>)
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+template <typename K, typename V>
+using concurrent_map = manifold::pool::concurrent_map<K, V>;
+#elif (MANIFOLD_PAR == 1) && __has_include(<tbb/concurrent_map.h>)
 #define TBB_PREVIEW_CONCURRENT_ORDERED_CONTAINERS 1
 #include <tbb/concurrent_map.h>
 #include <tbb/parallel_for.h>
@@ -29,7 +32,7 @@ template <typename K, typename V>
 using concurrent_map = tbb::concurrent_map<K, V>;
 #else
 template <typename K, typename V>
-// not really concurrent when tbb is disabled
+// not really concurrent when parallelism is disabled
 using concurrent_map = std::map<K, V>;
 #endif
 
@@ -250,21 +253,22 @@ void AddNewEdgeVerts(
       direction = !direction;
     }
   };
-#if (MANIFOLD_PAR == 1) && __has_include(<tbb/tbb.h>)
+#if (MANIFOLD_PAR == 1) && \
+    (defined(MANIFOLD_PAR_NATIVE) || __has_include(<tbb/concurrent_map.h>))
   // parallelize operations, requires concurrent_map so we can only enable this
-  // with tbb
+  // with a parallel backend
   if (p1q2.size() > kParallelThreshold) {
     // ideally we should have 1 mutex per key, but kParallelThreshold is enough
     // to avoid contention for most of the cases
     std::array<std::mutex, kParallelThreshold> mutexes;
-    static tbb::affinity_partitioner ap;
+    static par::affinity_partitioner ap;
     auto processFun = std::bind(
         process, [&](size_t hash) { mutexes[hash % mutexes.size()].lock(); },
         [&](size_t hash) { mutexes[hash % mutexes.size()].unlock(); },
         std::placeholders::_1);
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0_uz, p1q2.size(), 32),
-        [&](const tbb::blocked_range<size_t> &range) {
+    par::parallel_for(
+        par::blocked_range<size_t>(0_uz, p1q2.size(), 32),
+        [&](const par::blocked_range<size_t> &range) {
           for (size_t i = range.begin(); i != range.end(); i++) processFun(i);
         },
         ap);
@@ -23,10 +23,6 @@
 #include <intrin.h>
 #endif
 
-#if (MANIFOLD_PAR == 1)
-#include <tbb/combinable.h>
-#endif
-
 namespace manifold {
 
 namespace collider_internal {
@@ -34,6 +30,7 @@ namespace collider_internal {
 constexpr int kInitialLength = 128;
 constexpr int kLengthMultiple = 4;
 constexpr int kSequentialThreshold = 512;
+constexpr size_t kNumParallelPairs = 256;
 // Fundamental constants
 constexpr int kRoot = 1;
 
@@ -220,7 +217,7 @@ struct SeqCollisionRecorder {
 #if (MANIFOLD_PAR == 1)
 template <const bool inverted>
 struct ParCollisionRecorder {
-  tbb::combinable<SparseIndices>& store;
+  par::combinable<SparseIndices>& store;
   inline void record(int queryIdx, int leafIdx, SparseIndices& ind) const {
     // Add may invoke something in parallel, and it may return in
     // another thread, making thread local unsafe
@@ -257,6 +254,15 @@ struct TransformBox {
   void operator()(Box& box) { box = box.Transform(transform); }
 };
 
+// The bounding box of a box under an arbitrary affine transform.
+inline Box TransformedBox(const Box& box, const mat3x4& transform) {
+  const vec3 center = transform * vec4(box.Center(), 1.0);
+  const mat3 absLinear(la::abs(transform[0]), la::abs(transform[1]),
+                       la::abs(transform[2]));
+  const vec3 half = absLinear * (0.5 * box.Size());
+  return {center - half, center + half};
+}
+
 constexpr inline uint32_t SpreadBits3(uint32_t v) {
   v = 0xFF0000FFu & (v * 0x00010001u);
   v = 0x0F00F00Fu & (v * 0x00000101u);
@@ -329,7 +335,7 @@ class Collider {
     using collider_internal::FindCollision;
 #if (MANIFOLD_PAR == 1)
     if (queriesIn.size() > collider_internal::kSequentialThreshold) {
-      tbb::combinable<SparseIndices> store;
+      par::combinable<SparseIndices> store;
       for_each_n(
           ExecutionPolicy::Par, countAt(0), queriesIn.size(),
           FindCollision<T, selfCollision,
@@ -357,6 +363,180 @@ class Collider {
     return result;
   }
 
+  /**
+   * Calls f(leaf) for each leaf whose box overlaps the query. This runs in the
+   * calling thread, so callers can parallelize over their own queries without
+   * recording SparseIndices.
+   */
+  template <typename T, typename F>
+  void ForEachCollision(const T& query, F f) const {
+    using namespace collider_internal;
+    if (NumLeaves() == 0) return;
+    int stack[64];
+    int top = -1;
+    int node = kRoot;
+    auto visit = [&](int child) {
+      if (!nodeBBox_[child].DoesOverlap(query)) return false;
+      if (IsInternal(child)) return true;
+      f(Node2Leaf(child));
+      return false;
+    };
+    while (1) {
+      const int internal = Node2Internal(node);
+      const int child1 = internalChildren_[internal].first;
+      const int child2 = internalChildren_[internal].second;
+      const bool traverse1 = visit(child1);
+      const bool traverse2 = visit(child2);
+      if (!traverse1 && !traverse2) {
+        if (top < 0) break;
+        node = stack[top--];
+      } else {
+        node = traverse1 ? child1 : child2;
+        if (traverse1 && traverse2) stack[++top] = child2;
+      }
+    }
+  }
+
+  /**
+   * Finds the leaf minimizing leafDist(leaf) by a depth-first branch and bound
+   * that descends into the nearer child first. boxDist(box) returns a vec2
+   * whose x must be a lower bound of leafDist for every leaf within that box;
+   * its y breaks ties between children with equal bounds, e.g. boxes that both
+   * contain a query point. Only leaves nearer than the input dist are
+   * considered; on return dist holds the nearest distance found. Returns the
+   * nearest leaf, or -1 if none was nearer.
+   */
+  template <typename BoxDist, typename LeafDist>
+  int Nearest(BoxDist boxDist, LeafDist leafDist, double& dist) const {
+    using namespace collider_internal;
+    if (NumLeaves() == 0) return -1;
+    int nearest = -1;
+    std::pair<int, double> stack[64];
+    int top = -1;
+    int node = kRoot;
+    while (node >= 0) {
+      const int internal = Node2Internal(node);
+      int child[2] = {internalChildren_[internal].first,
+                      internalChildren_[internal].second};
+      vec2 childDist[2];
+      for (const int i : {0, 1}) {
+        childDist[i] = boxDist(nodeBBox_[child[i]]);
+        if (IsInternal(child[i]) || childDist[i].x >= dist) continue;
+        const int leaf = Node2Leaf(child[i]);
+        const double d = leafDist(leaf);
+        if (d < dist) {
+          dist = d;
+          nearest = leaf;
+        }
+        childDist[i].x = std::numeric_limits<double>::infinity();
+      }
+      if (childDist[1].x < childDist[0].x ||
+          (childDist[1].x == childDist[0].x &&
+           childDist[1].y < childDist[0].y)) {
+        std::swap(child[0], child[1]);
+        std::swap(childDist[0], childDist[1]);
+      }
+      if (childDist[1].x < dist) stack[++top] = {child[1], childDist[1].x};
+      node = childDist[0].x < dist ? child[0] : -1;
+      while (node < 0 && top >= 0) {
+        const auto [next, nextDist] = stack[top--];
+        if (nextDist < dist) node = next;
+      }
+    }
+    return nearest;
+  }
+
+  /**
+   * Calls f(leaf, otherLeaf) for each pair of leaves of this and other whose
+   * boxes overlap once other's are moved by transform, stopping early if f
+   * returns false. Both trees are descended together, so no transformed
+   * copies of other's boxes are stored. Large trees are first split into
+   * overlapping subtree pairs that are descended in parallel, so f must then
+   * be thread-safe, and calls already under way finish after one returns
+   * false.
+   */
+  template <typename F>
+  void ForEachCollision(const Collider& other, const mat3x4& transform,
+                        F f) const {
+    using namespace collider_internal;
+    if (NumLeaves() == 0 || other.NumLeaves() == 0) return;
+    const ExecutionPolicy policy =
+        autoPolicy(NumLeaves() + other.NumLeaves(), 1e4);
+    std::vector<std::pair<int, int>> starts = {{kRoot, kRoot}};
+    if (policy == ExecutionPolicy::Par)
+      starts = OverlapFrontier(other, transform, kNumParallelPairs);
+    std::atomic<bool> stop(false);
+    for_each_n(policy, countAt(0), starts.size(), [&](size_t i) {
+      std::vector<std::pair<int, int>> stack = {starts[i]};
+      while (!stack.empty() && !stop.load(std::memory_order_relaxed)) {
+        const auto [node, otherNode] = stack.back();
+        stack.pop_back();
+        const Box otherBox =
+            TransformedBox(other.nodeBBox_[otherNode], transform);
+        if (!nodeBBox_[node].DoesOverlap(otherBox)) continue;
+        if (IsLeaf(node) && IsLeaf(otherNode)) {
+          if (!f(Node2Leaf(node), Node2Leaf(otherNode))) stop = true;
+        } else {
+          PushChildPairs(other, node, otherNode, otherBox, stack);
+        }
+      }
+    });
+  }
+
+  /**
+   * Finds the pair of leaves of this and other, with other's moved by
+   * transform, that minimizes leafDist2(leaf, otherLeaf), a squared distance
+   * between contents that lie within their boxes. Like Nearest, only pairs
+   * nearer than the input dist2 are considered, and on return dist2 holds the
+   * nearest squared distance found.
+   */
+  template <typename LeafDist2>
+  void NearestPair(const Collider& other, const mat3x4& transform,
+                   LeafDist2 leafDist2, double& dist2) const {
+    using namespace collider_internal;
+    if (NumLeaves() == 0 || other.NumLeaves() == 0) return;
+    auto boxDist2 = [](const Box& a, const Box& b) {
+      const vec3 d = la::max(la::max(a.min - b.max, b.min - a.max), 0.0);
+      return la::dot(d, d);
+    };
+    std::vector<std::pair<int, int>> stack = {{kRoot, kRoot}};
+    while (!stack.empty()) {
+      const auto [node, otherNode] = stack.back();
+      stack.pop_back();
+      const Box otherBox =
+          TransformedBox(other.nodeBBox_[otherNode], transform);
+      if (boxDist2(nodeBBox_[node], otherBox) >= dist2) continue;
+      if (IsLeaf(node) && IsLeaf(otherNode)) {
+        dist2 =
+            std::min(dist2, leafDist2(Node2Leaf(node), Node2Leaf(otherNode)));
+        continue;
+      }
+      std::pair<int, int> pair[2];
+      double pairDist2[2];
+      if (SplitFirst(node, otherNode, otherBox)) {
+        const auto children = internalChildren_[Node2Internal(node)];
+        pair[0] = {children.first, otherNode};
+        pair[1] = {children.second, otherNode};
+        pairDist2[0] = boxDist2(nodeBBox_[children.first], otherBox);
+        pairDist2[1] = boxDist2(nodeBBox_[children.second], otherBox);
+      } else {
+        const auto children = other.internalChildren_[Node2Internal(otherNode)];
+        pair[0] = {node, children.first};
+        pair[1] = {node, children.second};
+        pairDist2[0] = boxDist2(
+            nodeBBox_[node],
+            TransformedBox(other.nodeBBox_[children.first], transform));
+        pairDist2[1] = boxDist2(
+            nodeBBox_[node],
+            TransformedBox(other.nodeBBox_[children.second], transform));
+      }
+      // Push the nearer pair last, so it is searched first.
+      if (pairDist2[0] < pairDist2[1]) std::swap(pair[0], pair[1]);
+      stack.push_back(pair[0]);
+      stack.push_back(pair[1]);
+    }
+  }
+
   static uint32_t MortonCode(vec3 position, Box bBox) {
     using collider_internal::SpreadBits3;
     vec3 xyz = (position - bBox.min) / (bBox.max - bBox.min);
@@ -374,6 +554,58 @@ class Collider {
   Vec<std::pair<int, int>> internalChildren_;
 
   size_t NumInternal() const { return internalChildren_.size(); };
+  // Whether to descend into node rather than otherNode when traversing two
+  // trees together: the larger box is split, unless it is a leaf.
+  bool SplitFirst(int node, int otherNode, const Box& otherBox) const {
+    using namespace collider_internal;
+    if (IsLeaf(otherNode)) return true;
+    if (IsLeaf(node)) return false;
+    return la::maxelem(nodeBBox_[node].Size()) >=
+           la::maxelem(otherBox.Size());
+  }
+  // Pushes the two pairs that node and otherNode split into when descending
+  // both trees together.
+  void PushChildPairs(const Collider& other, int node, int otherNode,
+                      const Box& otherBox,
+                      std::vector<std::pair<int, int>>& pairs) const {
+    using namespace collider_internal;
+    if (SplitFirst(node, otherNode, otherBox)) {
+      const auto children = internalChildren_[Node2Internal(node)];
+      pairs.push_back({children.first, otherNode});
+      pairs.push_back({children.second, otherNode});
+    } else {
+      const auto children = other.internalChildren_[Node2Internal(otherNode)];
+      pairs.push_back({node, children.first});
+      pairs.push_back({node, children.second});
+    }
+  }
+  // Descends both trees together breadth-first until there are at least
+  // minPairs overlapping node pairs, or only leaf pairs are left, so that
+  // their subtrees can be searched independently.
+  std::vector<std::pair<int, int>> OverlapFrontier(const Collider& other,
+                                                   const mat3x4& transform,
+                                                   size_t minPairs) const {
+    using namespace collider_internal;
+    std::vector<std::pair<int, int>> pairs = {{kRoot, kRoot}};
+    bool split = true;
+    while (split && pairs.size() < minPairs) {
+      split = false;
+      std::vector<std::pair<int, int>> next;
+      for (const auto [node, otherNode] : pairs) {
+        const Box otherBox =
+            TransformedBox(other.nodeBBox_[otherNode], transform);
+        if (!nodeBBox_[node].DoesOverlap(otherBox)) continue;
+        if (IsLeaf(node) && IsLeaf(otherNode)) {
+          next.push_back({node, otherNode});
+        } else {
+          PushChildPairs(other, node, otherNode, otherBox, next);
+          split = true;
+        }
+      }
+      pairs.swap(next);
+    }
+    return pairs;
+  }
   size_t NumLeaves() const {
     return internalChildren_.empty() ? 0 : (NumInternal() + 1);
   };
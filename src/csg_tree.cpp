@@ -12,15 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#if (MANIFOLD_PAR == 1) && __has_include(<tbb/concurrent_priority_queue.h>)
+#if (MANIFOLD_PAR == 1) && !defined(MANIFOLD_PAR_NATIVE) && \
+    __has_include(<tbb/concurrent_priority_queue.h>)
 #include <tbb/tbb.h>
 #define TBB_PREVIEW_CONCURRENT_ORDERED_CONTAINERS 1
 #include <tbb/concurrent_priority_queue.h>
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
 
 #include "./boolean3.h"
+#include "./collider.h"
 #include "./csg_tree.h"
 #include "./impl.h"
 #include "./mesh_fixes.h"
@@ -37,6 +43,263 @@ struct MeshCompare {
   }
 };
 
+// splitmix64 finalizer
+inline uint64_t Mix(uint64_t h) {
+  h += 0x9e3779b97f4a7c15ull;
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+  return h ^ (h >> 31);
+}
+
+inline uint64_t HashCombine(uint64_t seed, uint64_t value) {
+  return Mix(seed ^ Mix(value));
+}
+
+inline uint64_t HashDouble(double x) {
+  uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+inline uint64_t HashVec3(vec3 v) {
+  return HashCombine(HashCombine(HashDouble(v.x), HashDouble(v.y)),
+                     HashDouble(v.z));
+}
+
+// Each element is mixed with its index and the results are summed, so the
+// hash of a large vector is computed with a parallel reduction.
+template <typename T, typename F>
+uint64_t HashVec(const Vec<T> &vec, F hashElement) {
+  const uint64_t sum = manifold::transform_reduce(
+      autoPolicy(vec.size(), 1e4), countAt(0_uz), countAt(vec.size()),
+      static_cast<uint64_t>(0), std::plus<uint64_t>(),
+      [&vec, hashElement](size_t i) {
+        return Mix(hashElement(vec[i]) ^ Mix(i));
+      });
+  return HashCombine(sum, vec.size());
+}
+
+// Hash of everything in the Impl that can affect the result of a Boolean,
+// including the mesh relation, so a cached result is only reused for operands
+// with identical properties and IDs.
+uint64_t HashImpl(const Manifold::Impl &impl) {
+  uint64_t h = HashCombine(static_cast<uint64_t>(impl.status_),
+                           HashDouble(impl.epsilon_));
+  h = HashCombine(h, HashDouble(impl.tolerance_));
+  h = HashCombine(h, HashVec(impl.vertPos_, HashVec3));
+  h = HashCombine(h, HashVec(impl.faceNormal_, HashVec3));
+  h = HashCombine(h, HashVec(impl.halfedge_, [](const Halfedge &e) {
+                    return HashCombine(HashCombine(e.startVert, e.endVert),
+                                       e.pairedHalfedge);
+                  }));
+  h = HashCombine(h, HashVec(impl.halfedgeTangent_, [](const vec4 &t) {
+                    return HashCombine(HashVec3(vec3(t)), HashDouble(t.w));
+                  }));
+  const auto &relation = impl.meshRelation_;
+  h = HashCombine(h, relation.numProp);
+  h = HashCombine(h, HashVec(relation.properties, HashDouble));
+  h = HashCombine(h, HashVec(relation.triProperties, [](const ivec3 &tri) {
+                    return HashCombine(HashCombine(tri[0], tri[1]), tri[2]);
+                  }));
+  h = HashCombine(h, HashVec(relation.triRef, [](const TriRef &ref) {
+                    return HashCombine(
+                        HashCombine(HashCombine(ref.meshID, ref.originalID),
+                                    ref.tri),
+                        ref.faceID);
+                  }));
+  for (const auto &pair : relation.meshIDtransform) {
+    h = HashCombine(h, pair.first);
+    h = HashCombine(h, pair.second.originalID);
+    h = HashCombine(h, pair.second.backSide);
+    for (int col : {0, 1, 2, 3})
+      h = HashCombine(h, HashVec3(pair.second.transform[col]));
+  }
+  return h;
+}
+
+// Whether two Impls agree bit for bit on everything HashImpl covers, so that a
+// cache hit never relies on the hash alone.
+bool SameImpl(const Manifold::Impl &a, const Manifold::Impl &b) {
+  if (&a == &b) return true;
+  auto same = [](double x, double y) { return HashDouble(x) == HashDouble(y); };
+  auto sameVec3 = [&same](const vec3 &x, const vec3 &y) {
+    return same(x.x, y.x) && same(x.y, y.y) && same(x.z, y.z);
+  };
+  auto sameVec = [](const auto &x, const auto &y, auto sameElement) {
+    return x.size() == y.size() &&
+           all_of(countAt(0_uz), countAt(x.size()),
+                  [&](size_t i) { return sameElement(x[i], y[i]); });
+  };
+  const auto &relA = a.meshRelation_;
+  const auto &relB = b.meshRelation_;
+  if (a.status_ != b.status_ || !same(a.epsilon_, b.epsilon_) ||
+      !same(a.tolerance_, b.tolerance_) || relA.numProp != relB.numProp ||
+      relA.meshIDtransform.size() != relB.meshIDtransform.size())
+    return false;
+  for (auto itA = relA.meshIDtransform.begin(),
+            itB = relB.meshIDtransform.begin();
+       itA != relA.meshIDtransform.end(); ++itA, ++itB) {
+    if (itA->first != itB->first ||
+        itA->second.originalID != itB->second.originalID ||
+        itA->second.backSide != itB->second.backSide)
+      return false;
+    for (int col : {0, 1, 2, 3})
+      if (!sameVec3(itA->second.transform[col], itB->second.transform[col]))
+        return false;
+  }
+  return sameVec(a.vertPos_, b.vertPos_, sameVec3) &&
+         sameVec(a.faceNormal_, b.faceNormal_, sameVec3) &&
+         sameVec(a.halfedge_, b.halfedge_,
+                 [](const Halfedge &x, const Halfedge &y) {
+                   return x.startVert == y.startVert &&
+                          x.endVert == y.endVert &&
+                          x.pairedHalfedge == y.pairedHalfedge;
+                 }) &&
+         sameVec(a.halfedgeTangent_, b.halfedgeTangent_,
+                 [&](const vec4 &x, const vec4 &y) {
+                   return sameVec3(vec3(x), vec3(y)) && same(x.w, y.w);
+                 }) &&
+         sameVec(relA.properties, relB.properties, same) &&
+         sameVec(relA.triProperties, relB.triProperties,
+                 [](const ivec3 &x, const ivec3 &y) { return x == y; }) &&
+         sameVec(relA.triRef, relB.triRef,
+                 [](const TriRef &x, const TriRef &y) {
+                   return x.meshID == y.meshID &&
+                          x.originalID == y.originalID && x.tri == y.tri &&
+                          x.faceID == y.faceID;
+                 });
+}
+
+// Rough estimate of the memory held by an Impl, including its collider.
+size_t ImplMemory(const Manifold::Impl &impl) {
+  return impl.vertPos_.size() * sizeof(vec3) +
+         impl.halfedge_.size() * sizeof(Halfedge) +
+         impl.vertNormal_.size() * sizeof(vec3) +
+         impl.faceNormal_.size() * sizeof(vec3) +
+         impl.halfedgeTangent_.size() * sizeof(vec4) +
+         impl.meshRelation_.properties.size() * sizeof(double) +
+         impl.meshRelation_.triRef.size() * sizeof(TriRef) +
+         impl.meshRelation_.triProperties.size() * sizeof(ivec3) +
+         impl.NumTri() * (2 * sizeof(Box) + 2 * sizeof(int) +
+                          sizeof(std::pair<int, int>));
+}
+
+/**
+ * Size-bounded LRU cache of Boolean results, keyed on the content hashes of
+ * both operands and the operation. Each entry keeps its operands, which are
+ * compared with the query's on a hit, so a hash collision is only a miss.
+ */
+class BooleanCache {
+ public:
+  struct Key {
+    uint64_t a;
+    uint64_t b;
+    OpType op;
+    bool operator==(const Key &other) const {
+      return a == other.a && b == other.b && op == other.op;
+    }
+  };
+  using ImplPtr = std::shared_ptr<const Manifold::Impl>;
+
+  ImplPtr Find(const Key &key, const ImplPtr &a, const ImplPtr &b,
+               size_t maxMemory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Evict(maxMemory);
+    auto it = map_.find(key);
+    if (it == map_.end() || !SameImpl(*it->second->a, *a) ||
+        !SameImpl(*it->second->b, *b)) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    // move to the front, as the most recently used
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->result;
+  }
+
+  void Insert(const Key &key, const ImplPtr &a, const ImplPtr &b,
+              ImplPtr result, size_t maxMemory) {
+    // the operands are counted too, since the entry keeps them alive
+    const size_t memory = ImplMemory(*result) + ImplMemory(*a) + ImplMemory(*b);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (memory > maxMemory) return;
+    // replaces an entry computed concurrently, or one whose key collided
+    auto it = map_.find(key);
+    if (it != map_.end()) Erase(it->second);
+    lru_.push_front({key, a, b, result, memory});
+    map_[key] = lru_.begin();
+    stats_.memory += memory;
+    stats_.entries = lru_.size();
+    empty_ = false;
+    Evict(maxMemory);
+  }
+
+  /// Evicts the least recently used results until under maxMemory, e.g.
+  /// after the ceiling was lowered.
+  void Trim(size_t maxMemory) {
+    // cheap enough to call on every Boolean while the cache is disabled
+    if (empty_.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Evict(maxMemory);
+  }
+
+  BooleanCacheStats Stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.clear();
+    lru_.clear();
+    stats_ = BooleanCacheStats();
+    empty_ = true;
+  }
+
+ private:
+  struct Entry {
+    Key key;
+    ImplPtr a;
+    ImplPtr b;
+    ImplPtr result;
+    size_t memory;
+  };
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return HashCombine(HashCombine(key.a, key.b),
+                         static_cast<uint64_t>(key.op));
+    }
+  };
+
+  // must be called with the mutex held
+  void Erase(std::list<Entry>::iterator entry) {
+    stats_.memory -= entry->memory;
+    map_.erase(entry->key);
+    lru_.erase(entry);
+    stats_.entries = lru_.size();
+    empty_ = lru_.empty();
+  }
+
+  // must be called with the mutex held
+  void Evict(size_t maxMemory) {
+    while (stats_.memory > maxMemory) {
+      Erase(std::prev(lru_.end()));
+      ++stats_.evictions;
+    }
+  }
+
+  std::mutex mutex_;
+  std::list<Entry> lru_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> map_;
+  BooleanCacheStats stats_;
+  std::atomic<bool> empty_{true};
+};
+
+BooleanCache &GetBooleanCache() {
+  static BooleanCache cache;
+  return cache;
+}
+
 }  // namespace
 namespace manifold {
 
@@ -90,6 +353,10 @@ CsgLeafNode::CsgLeafNode(std::shared_ptr<const Manifold::Impl> pImpl_,
                          mat3x4 transform_)
     : pImpl_(pImpl_), transform_(transform_) {}
 
+// Wraps this node for the callbacks of the public API, sharing it rather than
+// copying its mesh.
+Manifold CsgLeafNode::AsManifold() { return Manifold(shared_from_this()); }
+
 std::shared_ptr<const Manifold::Impl> CsgLeafNode::GetImpl() const {
   if (transform_ == mat3x4(la::identity)) return pImpl_;
   pImpl_ =
@@ -156,6 +423,35 @@ std::shared_ptr<CsgLeafNode> SimpleBoolean(const Manifold::Impl &a,
 #endif
 }
 
+/**
+ * Boolean of two leaf nodes. When the Boolean cache is enabled, a previous
+ * result is reused if the same operation was performed on operands with
+ * identical content. The leaf transforms are included in the key, since the
+ * operands are hashed after their transform has been applied.
+ */
+std::shared_ptr<CsgLeafNode> SimpleBoolean(
+    const std::shared_ptr<CsgLeafNode> &a,
+    const std::shared_ptr<CsgLeafNode> &b, OpType op) {
+  const size_t maxMemory = ManifoldParams().booleanCacheSize;
+  BooleanCache &cache = GetBooleanCache();
+  if (maxMemory == 0) {
+    // release the results of an earlier, enabled cache
+    cache.Trim(0);
+    return SimpleBoolean(*a->GetImpl(), *b->GetImpl(), op);
+  }
+
+  const auto implA = a->GetImpl();
+  const auto implB = b->GetImpl();
+  const BooleanCache::Key key = {HashImpl(*implA), HashImpl(*implB), op};
+  std::shared_ptr<const Manifold::Impl> cached =
+      cache.Find(key, implA, implB, maxMemory);
+  if (cached != nullptr) return std::make_shared<CsgLeafNode>(cached);
+
+  std::shared_ptr<CsgLeafNode> result = SimpleBoolean(*implA, *implB, op);
+  cache.Insert(key, implA, implB, result->GetImpl(), maxMemory);
+  return result;
+}
+
 /**
  * Efficient union of a set of pairwise disjoint meshes.
  */
@@ -338,6 +634,171 @@ std::shared_ptr<CsgLeafNode> CsgLeafNode::Compose(
   return ImplToLeaf(std::move(combined));
 }
 
+using BooleanCost =
+    std::function<double(const std::shared_ptr<CsgLeafNode> &,
+                         const std::shared_ptr<CsgLeafNode> &)>;
+
+// Number of triangle pairs whose bounding boxes overlap within the region,
+// which is what the Boolean has to test for intersections.
+size_t CandidatePairs(const Manifold::Impl &a, const Manifold::Impl &b,
+                      const Box &region) {
+  Vec<Box> query(1, region);
+  const SparseIndices faces = a.collider_.Collisions(query.cview());
+  Vec<Box> faceBox(faces.size());
+  for_each_n(autoPolicy(faces.size(), 1e4), countAt(0_uz), faces.size(),
+             [&a, &faces, &faceBox](size_t i) {
+               const int tri = faces.Get(i, true);
+               Box box;
+               for (const int j : {0, 1, 2})
+                 box.Union(a.vertPos_[a.halfedge_[3 * tri + j].startVert]);
+               faceBox[i] = box;
+             });
+  return b.collider_.Collisions(faceBox.cview()).size();
+}
+
+// Every Boolean copies both operands, while the intersection work is limited
+// to the overlap of their bounding boxes. Disjoint operands are therefore
+// cheap no matter their size.
+double EstimateBooleanCost(const Manifold::Impl &a, const Manifold::Impl &b) {
+  constexpr double kCandidateCost = 4;
+  const double copyCost = a.NumVert() + b.NumVert();
+  Box overlap;
+  overlap.min = la::max(a.bBox_.min, b.bBox_.min);
+  overlap.max = la::min(a.bBox_.max, b.bBox_.max);
+  if (a.IsEmpty() || b.IsEmpty() ||
+      !la::all(la::less(overlap.min, overlap.max)))
+    return copyCost;
+  return copyCost + kCandidateCost * CandidatePairs(a, b, overlap);
+}
+
+/**
+ * Combines the operands pairwise, always choosing the pair with the lowest
+ * cost among those available. The cost of every pair is evaluated, so this is
+ * only suitable for moderate numbers of operands.
+ */
+std::shared_ptr<CsgLeafNode> CheapestFirstBoolean(
+    OpType operation, std::vector<std::shared_ptr<CsgLeafNode>> &results,
+    const BooleanCost &cost) {
+  ZoneScoped;
+  struct Pair {
+    double cost;
+    size_t a;
+    size_t b;
+    bool operator<(const Pair &other) const { return cost > other.cost; }
+  };
+  // operands are never removed, only marked as consumed, so indices into
+  // nodes are stable; the heap entries of consumed operands are skipped.
+  std::vector<std::shared_ptr<CsgLeafNode>> nodes;
+  std::vector<bool> available;
+  std::vector<Pair> heap;
+  size_t numAvailable = 0;
+  auto add = [&](size_t i, const std::vector<Pair> &pairs) {
+    DEBUG_ASSERT(i == nodes.size() - 1, logicErr, "nodes added out of order");
+    available.push_back(true);
+    ++numAvailable;
+    for (const Pair &pair : pairs) {
+      heap.push_back(pair);
+      std::push_heap(heap.begin(), heap.end());
+    }
+  };
+  auto cheapest = [&](Pair &pair) {
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end());
+      pair = heap.back();
+      heap.pop_back();
+      if (available[pair.a] && available[pair.b]) {
+        available[pair.a] = false;
+        available[pair.b] = false;
+        numAvailable -= 2;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  const size_t numOperand = results.size();
+  nodes = std::move(results);
+  results.clear();
+  // apply any pending transforms before the costs are evaluated in parallel
+  for (auto &node : nodes) node->GetImpl();
+  std::vector<Pair> pairs(numOperand * (numOperand - 1) / 2);
+  for_each_n(autoPolicy(pairs.size(), 64), countAt(0_uz), numOperand,
+             [&nodes, &pairs, &cost](size_t i) {
+               // pairs (j, i) for j < i start at i * (i - 1) / 2
+               for (size_t j = 0; j < i; ++j)
+                 pairs[i * (i - 1) / 2 + j] = {cost(nodes[j], nodes[i]), j, i};
+             });
+  available.assign(numOperand, true);
+  numAvailable = numOperand;
+  heap = std::move(pairs);
+  std::make_heap(heap.begin(), heap.end());
+
+#if (MANIFOLD_PAR == 1) && \
+    (defined(MANIFOLD_PAR_NATIVE) || __has_include(<tbb/tbb.h>))
+  par::task_group group;
+  std::mutex mutex;
+  // Starts every pair that is ready. The tasks are spawned after the mutex is
+  // released, since an executor may run them inline on this thread.
+  std::function<void()> dispatch = [&]() {
+    std::vector<std::pair<std::shared_ptr<CsgLeafNode>,
+                          std::shared_ptr<CsgLeafNode>>>
+        ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      Pair pair;
+      while (numAvailable > 1 && cheapest(pair))
+        ready.push_back({nodes[pair.a], nodes[pair.b]});
+    }
+    for (const auto &[a, b] : ready) {
+      group.run([&, a = a, b = b]() {
+        auto result = SimpleBoolean(a, b, operation);
+        std::vector<std::pair<size_t, std::shared_ptr<CsgLeafNode>>> others;
+        size_t known;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          known = nodes.size();
+          for (size_t i = 0; i < known; ++i)
+            if (available[i]) others.push_back({i, nodes[i]});
+        }
+        // the costs are evaluated without the lock, so that other Booleans
+        // can finish meanwhile; their results are paired up below.
+        std::vector<Pair> newPairs;
+        for (const auto &other : others)
+          newPairs.push_back({cost(other.second, result), other.first, 0});
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          const size_t i = nodes.size();
+          for (size_t j = known; j < i; ++j)
+            if (available[j])
+              newPairs.push_back({cost(nodes[j], result), j, 0});
+          for (Pair &newPair : newPairs) newPair.b = i;
+          nodes.push_back(result);
+          add(i, newPairs);
+        }
+        dispatch();
+      });
+    }
+  };
+  dispatch();
+  group.wait();
+#else
+  Pair pair;
+  while (numAvailable > 1 && cheapest(pair)) {
+    auto result = SimpleBoolean(nodes[pair.a], nodes[pair.b], operation);
+    const size_t i = nodes.size();
+    std::vector<Pair> newPairs;
+    for (size_t j = 0; j < i; ++j)
+      if (available[j])
+        newPairs.push_back({cost(nodes[j], result), j, i});
+    nodes.push_back(result);
+    add(i, newPairs);
+  }
+#endif
+  for (size_t i = 0; i < nodes.size(); ++i)
+    if (available[i]) return nodes[i];
+  return std::make_shared<CsgLeafNode>();
+}
+
 /**
  * Efficient boolean operation on a set of nodes utilizing commutativity of the
  * operation. Only supports union and intersection.
@@ -351,11 +812,32 @@ std::shared_ptr<CsgLeafNode> BatchBoolean(
   if (results.size() == 0) return std::make_shared<CsgLeafNode>();
   if (results.size() == 1) return results.front();
   if (results.size() == 2)
-    return SimpleBoolean(*results[0]->GetImpl(), *results[1]->GetImpl(),
-                         operation);
-#if (MANIFOLD_PAR == 1) && __has_include(<tbb/tbb.h>)
-  tbb::task_group group;
-  tbb::concurrent_priority_queue<std::shared_ptr<CsgLeafNode>, MeshCompare>
+    return SimpleBoolean(results[0], results[1], operation);
+  // Evaluating the cost of every pair is quadratic in the number of operands,
+  // so larger batches silently fall back to the vertex count order below, as
+  // documented on BatchOrder::CostModel.
+  constexpr size_t kMaxCostModelSize = 256;
+  if (ManifoldParams().batchOrder == BatchOrder::CostModel &&
+      results.size() <= kMaxCostModelSize) {
+    const auto batchCost = ManifoldParams().batchCost;
+    if (batchCost)
+      return CheapestFirstBoolean(
+          operation, results,
+          [&batchCost](const std::shared_ptr<CsgLeafNode> &a,
+                       const std::shared_ptr<CsgLeafNode> &b) {
+            return batchCost(a->AsManifold(), b->AsManifold());
+          });
+    return CheapestFirstBoolean(
+        operation, results,
+        [](const std::shared_ptr<CsgLeafNode> &a,
+           const std::shared_ptr<CsgLeafNode> &b) {
+          return EstimateBooleanCost(*a->GetImpl(), *b->GetImpl());
+        });
+  }
+#if (MANIFOLD_PAR == 1) && \
+    (defined(MANIFOLD_PAR_NATIVE) || __has_include(<tbb/tbb.h>))
+  par::task_group group;
+  par::concurrent_priority_queue<std::shared_ptr<CsgLeafNode>, MeshCompare>
       queue(results.size());
   for (auto result : results) {
     queue.emplace(result);
@@ -370,7 +852,7 @@ std::shared_ptr<CsgLeafNode> BatchBoolean(
         continue;
       }
       group.run([&, a, b]() {
-        queue.emplace(SimpleBoolean(*a->GetImpl(), *b->GetImpl(), operation));
+        queue.emplace(SimpleBoolean(a, b, operation));
         return group.run(process);
       });
     }
@@ -393,7 +875,7 @@ std::shared_ptr<CsgLeafNode> BatchBoolean(
     auto b = std::move(results.back());
     results.pop_back();
     // boolean operation
-    auto result = SimpleBoolean(*a->GetImpl(), *b->GetImpl(), operation);
+    auto result = SimpleBoolean(a, b, operation);
     if (results.size() == 0) return result;
     results.push_back(result);
     std::push_heap(results.begin(), results.end(), cmpFn);
@@ -409,59 +891,81 @@ std::shared_ptr<CsgLeafNode> BatchUnion(
     std::vector<std::shared_ptr<CsgLeafNode>> &children) {
   ZoneScoped;
   // INVARIANT: children_ is a vector of leaf nodes
-  // this kMaxUnionSize is a heuristic to avoid the pairwise disjoint check
-  // with O(n^2) complexity to take too long.
-  // If the number of children exceeded this limit, we will operate on chunks
-  // with size kMaxUnionSize.
-  constexpr size_t kMaxUnionSize = 1000;
   DEBUG_ASSERT(!children.empty(), logicErr,
                "BatchUnion should not have empty children");
-  while (children.size() > 1) {
-    const size_t start = (children.size() > kMaxUnionSize)
-                             ? (children.size() - kMaxUnionSize)
-                             : 0;
-    Vec<Box> boxes;
-    boxes.reserve(children.size() - start);
-    for (size_t i = start; i < children.size(); i++) {
-      boxes.push_back(children[i]->GetImpl()->bBox_);
-    }
-    // partition the children into a set of disjoint sets
-    // each set contains a set of children that are pairwise disjoint
-    std::vector<Vec<size_t>> disjointSets;
-    for (size_t i = 0; i < boxes.size(); i++) {
-      auto lambda = [&boxes, i](const Vec<size_t> &set) {
-        return std::find_if(set.begin(), set.end(), [&boxes, i](size_t j) {
-                 return boxes[i].DoesOverlap(boxes[j]);
-               }) == set.end();
-      };
-      auto it = std::find_if(disjointSets.begin(), disjointSets.end(), lambda);
-      if (it == disjointSets.end()) {
-        disjointSets.push_back(std::vector<size_t>{i});
-      } else {
-        it->push_back(i);
-      }
+  // empty children do not contribute to the union
+  std::vector<std::shared_ptr<CsgLeafNode>> nodes;
+  nodes.reserve(children.size());
+  for (auto &child : children) {
+    if (!child->GetImpl()->IsEmpty()) nodes.push_back(child);
+  }
+  if (nodes.size() < 2) return nodes.empty() ? children.front() : nodes[0];
+
+  // sort the children along a Morton curve so a Collider can be built over
+  // their bounding boxes
+  const size_t numNode = nodes.size();
+  Vec<Box> boxes(numNode);
+  Box bounds;
+  for (size_t i = 0; i < numNode; ++i) {
+    boxes[i] = nodes[i]->GetImpl()->bBox_;
+    bounds = bounds.Union(boxes[i]);
+  }
+  Vec<uint32_t> morton(numNode);
+  for_each_n(autoPolicy(numNode, 1e4), countAt(0_uz), numNode,
+             [&morton, &boxes, &bounds](size_t i) {
+               morton[i] = Collider::MortonCode(boxes[i].Center(), bounds);
+             });
+  Vec<size_t> new2Old(numNode);
+  sequence(new2Old.begin(), new2Old.end());
+  stable_sort(new2Old.begin(), new2Old.end(),
+              [&morton](const size_t a, const size_t b) {
+                return morton[a] < morton[b];
+              });
+  Permute(morton, new2Old);
+  Permute(boxes, new2Old);
+  Permute(nodes, new2Old);
+
+  // all overlapping pairs, in both directions, sorted by the first index
+  SparseIndices overlaps =
+      Collider(boxes, morton).Collisions<true>(boxes.cview());
+  overlaps.Sort();
+
+  // partition the children into a set of disjoint sets, each containing
+  // children that are pairwise disjoint, by greedily coloring the overlap
+  // graph. Every child takes the lowest set not used by any of its overlapping
+  // predecessors, which only requires visiting each overlap once.
+  std::vector<int> setOf(numNode, -1);
+  std::vector<size_t> usedBy;
+  int numSet = 0;
+  size_t k = 0;
+  for (size_t i = 0; i < numNode; ++i) {
+    for (; k < overlaps.size() && overlaps.Get(k, false) == (int)i; ++k) {
+      const int set = setOf[overlaps.Get(k, true)];
+      if (set >= 0) usedBy[set] = i;
     }
-    // compose each set of disjoint children
-    std::vector<std::shared_ptr<CsgLeafNode>> impls;
-    for (auto &set : disjointSets) {
-      if (set.size() == 1) {
-        impls.push_back(children[start + set[0]]);
-      } else {
-        std::vector<std::shared_ptr<CsgLeafNode>> tmp;
-        for (size_t j : set) {
-          tmp.push_back(children[start + j]);
-        }
-        impls.push_back(CsgLeafNode::Compose(tmp));
-      }
+    int set = 0;
+    while (set < numSet && usedBy[set] == i) ++set;
+    if (set == numSet) {
+      ++numSet;
+      usedBy.push_back(numNode);
     }
+    setOf[i] = set;
+  }
+  std::vector<std::vector<std::shared_ptr<CsgLeafNode>>> disjointSets(numSet);
+  for (size_t i = 0; i < numNode; ++i) {
+    disjointSets[setOf[i]].push_back(nodes[i]);
+  }
 
-    children.erase(children.begin() + start, children.end());
-    children.push_back(BatchBoolean(OpType::Add, impls));
-    // move it to the front as we process from the back, and the newly added
-    // child should be quite complicated
-    std::swap(children.front(), children.back());
+  // compose each set of disjoint children
+  std::vector<std::shared_ptr<CsgLeafNode>> impls;
+  for (auto &set : disjointSets) {
+    if (set.size() == 1) {
+      impls.push_back(set[0]);
+    } else {
+      impls.push_back(CsgLeafNode::Compose(set));
+    }
   }
-  return children.front();
+  return impls.size() == 1 ? impls[0] : BatchBoolean(OpType::Add, impls);
 }
 
 CsgOpNode::CsgOpNode() {}
@@ -490,59 +994,122 @@ std::shared_ptr<CsgNode> CsgOpNode::Transform(const mat3x4 &m) const {
   return node;
 }
 
-struct CsgStackFrame {
+struct CsgTask {
   using Nodes = std::vector<std::shared_ptr<CsgLeafNode>>;
 
-  bool finalize;
+  std::shared_ptr<const CsgOpNode> op_node;
+  mat3x4 transform;
+  // slot reserved in the parent's children set for the result of this task,
+  // nullptr for the root.
+  Nodes *dest;
+  size_t dest_index;
+  // an alias refers to an op node whose shared impl is evaluated by another
+  // task, it only needs to transform and forward that result.
+  bool alias;
+  Nodes positive_children;
+  Nodes negative_children;
+  // number of tasks that must complete before this one can run
+  std::atomic<int> pending{0};
+  // tasks waiting on this one: the parent (owner of `dest`) and aliases
+  std::vector<CsgTask *> dependents;
+
+  CsgTask(std::shared_ptr<const CsgOpNode> op_node, mat3x4 transform,
+          Nodes *dest, bool alias)
+      : op_node(op_node), transform(transform), dest(dest), alias(alias) {
+    if (dest != nullptr) {
+      dest_index = dest->size();
+      dest->push_back(nullptr);
+    }
+  }
+
+  // `task` cannot run before this one completes.
+  void AddDependent(CsgTask *task) {
+    dependents.push_back(task);
+    ++task->pending;
+  }
+};
+
+struct CsgStackFrame {
+  using Nodes = CsgTask::Nodes;
+
   OpType parent_op;
   mat3x4 transform;
   Nodes *positive_dest;
   Nodes *negative_dest;
+  // task owning the destination sets, nullptr for the root
+  CsgTask *parent;
   std::shared_ptr<const CsgOpNode> op_node;
-  Nodes positive_children;
-  Nodes negative_children;
-
-  CsgStackFrame(bool finalize, OpType parent_op, mat3x4 transform,
-                Nodes *positive_dest, Nodes *negative_dest,
-                std::shared_ptr<const CsgOpNode> op_node)
-      : finalize(finalize),
-        parent_op(parent_op),
-        transform(transform),
-        positive_dest(positive_dest),
-        negative_dest(negative_dest),
-        op_node(op_node) {}
 };
 
+void CsgOpNode::Finalize(CsgTask &task) {
+  auto impl = task.op_node->impl_.GetGuard();
+  if (task.alias) {
+    (*task.dest)[task.dest_index] = std::static_pointer_cast<CsgLeafNode>(
+        impl->children_[0]->Transform(task.transform));
+    return;
+  }
+  switch (task.op_node->op_) {
+    case OpType::Add:
+      impl->children_ = {BatchUnion(task.positive_children)};
+      break;
+    case OpType::Intersect: {
+      impl->children_ = {
+          BatchBoolean(OpType::Intersect, task.positive_children)};
+      break;
+    };
+    case OpType::Subtract:
+      if (task.positive_children.empty()) {
+        // nothing to subtract from, so the result is empty.
+        impl->children_ = {std::make_shared<CsgLeafNode>()};
+      } else {
+        auto positive = BatchUnion(task.positive_children);
+        if (task.negative_children.empty()) {
+          // nothing to subtract, result equal to the LHS.
+          impl->children_ = {positive};
+        } else {
+          auto negative = BatchUnion(task.negative_children);
+          impl->children_ = {
+              SimpleBoolean(positive, negative, OpType::Subtract)};
+        }
+      }
+      break;
+  }
+  task.op_node->cache_ = std::static_pointer_cast<CsgLeafNode>(
+      impl->children_[0]->Transform(task.op_node->transform_));
+  if (task.dest != nullptr)
+    (*task.dest)[task.dest_index] = std::static_pointer_cast<CsgLeafNode>(
+        task.op_node->cache_->Transform(task.transform));
+}
+
 std::shared_ptr<CsgLeafNode> CsgOpNode::ToLeafNode() const {
   if (cache_ != nullptr) return cache_;
 
-  // Note: We do need a pointer here to avoid vector pointers from being
-  // invalidated after pushing elements into the explicit stack.
-  // It is a `shared_ptr` because we may want to drop the stack frame while
-  // still referring to some of the elements inside the old frame.
-  // It is possible to use `unique_ptr`, extending the lifetime of the frame
-  // when we remove it from the stack, but it is a bit more complicated and
-  // there is no measurable overhead from using `shared_ptr` here...
-  std::vector<std::shared_ptr<CsgStackFrame>> stack;
+  // Tasks are heap allocated so the `dest` pointers into their children sets
+  // stay valid while the task list grows.
+  std::vector<std::unique_ptr<CsgTask>> tasks;
+  // Maps the shared impl of an op node to the task evaluating it, so nodes
+  // reused in several places of the DAG are only evaluated once.
+  std::unordered_map<const void *, CsgTask *> scheduled;
+  std::vector<CsgStackFrame> stack;
   // initial node, positive_dest is a nullptr because we don't need to put the
   // result anywhere else (except in the cache_).
-  stack.push_back(std::make_shared<CsgStackFrame>(
-      false, op_, la::identity, nullptr, nullptr,
-      std::static_pointer_cast<const CsgOpNode>(shared_from_this())));
+  stack.push_back({op_, la::identity, nullptr, nullptr, nullptr,
+                   std::static_pointer_cast<const CsgOpNode>(
+                       shared_from_this())});
 
-  // Instead of actually using recursion in the algorithm, we use an explicit
-  // stack, do DFS and store the intermediate states into `CsgStackFrame` to
-  // avoid stack overflow.
+  // Evaluation happens in two phases. First, we walk the tree with an explicit
+  // stack, to avoid stack overflow, and build a task graph with one task per
+  // op node that needs a Boolean. Second, we run each task as soon as all the
+  // tasks it depends on have completed, so independent subtrees are evaluated
+  // concurrently when parallelization is enabled.
   //
   // Before performing boolean operations, we should make sure that all children
   // are `CsgLeafNodes`, i.e. are actual meshes that can be operated on. Hence,
-  // we do it in two steps:
-  // 1. Populate `children` (`positive_children` and `negative_children`)
-  //    If the child is a `CsgOpNode`, we either collapse it or compute its
-  //    boolean operation result.
-  // 2. Performs boolean after populating the `children` set.
-  //    After a boolean operation is completed, we put the result back to its
-  //    parent's `children` set.
+  // a task depends on every task that produces one of its `children`
+  // (`positive_children` and `negative_children`). When a task completes, it
+  // writes its result into a slot of its parent's `children` set that was
+  // reserved during the walk, so the order of the children set does not depend
+  // on the scheduling order.
   //
   // When we populate `children`, we perform collapsing on-the-fly.
   // For example, we want to turn `(Union a (Union b c))` into `(Union a b c)`.
@@ -573,6 +1140,8 @@ std::shared_ptr<CsgLeafNode> CsgOpNode::ToLeafNode() const {
   // the NOT transformed result, while `cache_` should contain the transformed
   // result. This is because `impl` can be shared between `CsgOpNode` that
   // differ in `transform_`, so we want it to be able to share the result.
+  // A reused node that is already scheduled becomes an alias task, which waits
+  // for the scheduled task and only applies its own transform to the result.
   // ===========================================================================
   // Recursive version (pseudocode only):
   //
@@ -615,85 +1184,90 @@ std::shared_ptr<CsgLeafNode> CsgOpNode::ToLeafNode() const {
   //     destination->push_back(node->cache_->Transform(transform));
   // }
   while (!stack.empty()) {
-    std::shared_ptr<CsgStackFrame> frame = stack.back();
-    auto impl = frame->op_node->impl_.GetGuard();
-    if (frame->finalize) {
-      switch (frame->op_node->op_) {
-        case OpType::Add:
-          impl->children_ = {BatchUnion(frame->positive_children)};
-          break;
-        case OpType::Intersect: {
-          impl->children_ = {
-              BatchBoolean(OpType::Intersect, frame->positive_children)};
-          break;
-        };
-        case OpType::Subtract:
-          if (frame->positive_children.empty()) {
-            // nothing to subtract from, so the result is empty.
-            impl->children_ = {std::make_shared<CsgLeafNode>()};
-          } else {
-            auto positive = BatchUnion(frame->positive_children);
-            if (frame->negative_children.empty()) {
-              // nothing to subtract, result equal to the LHS.
-              impl->children_ = {frame->positive_children[0]};
-            } else {
-              auto negative = BatchUnion(frame->negative_children);
-              impl->children_ = {SimpleBoolean(*positive->GetImpl(),
-                                               *negative->GetImpl(),
-                                               OpType::Subtract)};
-            }
-          }
-          break;
-      }
-      frame->op_node->cache_ = std::static_pointer_cast<CsgLeafNode>(
-          impl->children_[0]->Transform(frame->op_node->transform_));
-      if (frame->positive_dest != nullptr)
-        frame->positive_dest->push_back(std::static_pointer_cast<CsgLeafNode>(
-            frame->op_node->cache_->Transform(frame->transform)));
-      stack.pop_back();
-    } else {
-      auto add_children =
-          [&stack](std::shared_ptr<CsgNode> &node, OpType op, mat3x4 transform,
-                   CsgStackFrame::Nodes *dest1, CsgStackFrame::Nodes *dest2) {
-            if (node->GetNodeType() == CsgNodeType::Leaf)
-              dest1->push_back(std::static_pointer_cast<CsgLeafNode>(
-                  node->Transform(transform)));
-            else
-              stack.push_back(std::make_shared<CsgStackFrame>(
-                  false, op, transform, dest1, dest2,
-                  std::static_pointer_cast<const CsgOpNode>(node)));
-          };
-      // op_node use_count == 2 because it is both inside one CsgOpNode
-      // and in our stack.
-      // if there is only one child, we can also collapse.
-      const OpType op = frame->op_node->op_;
-      const bool canCollapse =
-          frame->positive_dest != nullptr &&
-          ((op == frame->parent_op && frame->op_node.use_count() <= 2 &&
-            frame->op_node->impl_.UseCount() == 1) ||
-           impl->children_.size() == 1);
-      if (canCollapse)
-        stack.pop_back();
+    const CsgStackFrame frame = std::move(stack.back());
+    stack.pop_back();
+    auto impl = frame.op_node->impl_.GetGuard();
+
+    auto it = scheduled.find(&*impl);
+    if (it != scheduled.end()) {
+      // the shared impl has already been scheduled, and will have a single
+      // child once evaluated, so this node will be collapsed.
+      tasks.push_back(std::make_unique<CsgTask>(
+          frame.op_node, frame.transform * Mat4(frame.op_node->transform_),
+          frame.positive_dest, true));
+      it->second->AddDependent(tasks.back().get());
+      tasks.back()->AddDependent(frame.parent);
+      continue;
+    }
+
+    // op_node use_count == 2 because it is both inside one CsgOpNode
+    // and in our stack.
+    // if there is only one child, we can also collapse.
+    const OpType op = frame.op_node->op_;
+    const bool canCollapse =
+        frame.positive_dest != nullptr &&
+        ((op == frame.parent_op && frame.op_node.use_count() <= 2 &&
+          frame.op_node->impl_.UseCount() == 1) ||
+         impl->children_.size() == 1);
+
+    CsgTask *parent = frame.parent;
+    const mat3x4 transform =
+        canCollapse ? (frame.transform * Mat4(frame.op_node->transform_))
+                    : la::identity;
+    CsgStackFrame::Nodes *pos_dest = frame.positive_dest;
+    CsgStackFrame::Nodes *neg_dest = frame.negative_dest;
+    if (!canCollapse) {
+      tasks.push_back(std::make_unique<CsgTask>(
+          frame.op_node, frame.transform, frame.positive_dest, false));
+      CsgTask *task = tasks.back().get();
+      if (frame.parent != nullptr) task->AddDependent(frame.parent);
+      scheduled[&*impl] = task;
+      parent = task;
+      pos_dest = &task->positive_children;
+      neg_dest = &task->negative_children;
+    }
+
+    for (size_t i = 0; i < impl->children_.size(); i++) {
+      const bool negative = op == OpType::Subtract && i != 0;
+      CsgStackFrame::Nodes *dest1 = negative ? neg_dest : pos_dest;
+      CsgStackFrame::Nodes *dest2 =
+          (op == OpType::Subtract && i == 0) ? neg_dest : nullptr;
+      std::shared_ptr<CsgNode> &child = impl->children_[i];
+      if (child->GetNodeType() == CsgNodeType::Leaf)
+        dest1->push_back(
+            std::static_pointer_cast<CsgLeafNode>(child->Transform(transform)));
       else
-        frame->finalize = true;
-
-      const mat3x4 transform =
-          canCollapse ? (frame->transform * Mat4(frame->op_node->transform_))
-                      : la::identity;
-      CsgStackFrame::Nodes *pos_dest =
-          canCollapse ? frame->positive_dest : &frame->positive_children;
-      CsgStackFrame::Nodes *neg_dest =
-          canCollapse ? frame->negative_dest : &frame->negative_children;
-      for (size_t i = 0; i < impl->children_.size(); i++) {
-        const bool negative = op == OpType::Subtract && i != 0;
-        CsgStackFrame::Nodes *dest1 = negative ? neg_dest : pos_dest;
-        CsgStackFrame::Nodes *dest2 =
-            (op == OpType::Subtract && i == 0) ? neg_dest : nullptr;
-        add_children(impl->children_[i], negative ? OpType::Add : op, transform,
-                     dest1, dest2);
-      }
+        stack.push_back({negative ? OpType::Add : op, transform, dest1, dest2,
+                         parent,
+                         std::static_pointer_cast<const CsgOpNode>(child)});
     }
   }
+
+  std::vector<CsgTask *> ready;
+  for (auto &task : tasks)
+    if (task->pending == 0) ready.push_back(task.get());
+
+#if (MANIFOLD_PAR == 1) && \
+    (defined(MANIFOLD_PAR_NATIVE) || __has_include(<tbb/tbb.h>))
+  par::task_group group;
+  std::function<void(CsgTask *)> run = [&group, &run](CsgTask *task) {
+    group.run([task, &run]() {
+      Finalize(*task);
+      for (CsgTask *dependent : task->dependents)
+        if (--dependent->pending == 0) run(dependent);
+    });
+  };
+  for (CsgTask *task : ready) run(task);
+  group.wait();
+#else
+  while (!ready.empty()) {
+    CsgTask *task = ready.back();
+    ready.pop_back();
+    Finalize(*task);
+    for (CsgTask *dependent : task->dependents)
+      if (--dependent->pending == 0) ready.push_back(dependent);
+  }
+#endif
   return cache_;
 }
 
@@ -710,4 +1284,12 @@ CsgNodeType CsgOpNode::GetNodeType() const {
   return CsgNodeType::Leaf;
 }
 
+BooleanCacheStats GetBooleanCacheStats() {
+  BooleanCache &cache = GetBooleanCache();
+  cache.Trim(ManifoldParams().booleanCacheSize);
+  return cache.Stats();
+}
+
+void ClearBooleanCache() { GetBooleanCache().Clear(); }
+
 }  // namespace manifold
@@ -21,6 +21,7 @@ namespace manifold {
 enum class CsgNodeType { Union, Intersection, Difference, Leaf };
 
 class CsgLeafNode;
+struct CsgTask;
 
 class CsgNode : public std::enable_shared_from_this<CsgNode> {
  public:
@@ -44,6 +45,7 @@ class CsgLeafNode final : public CsgNode {
   CsgLeafNode(std::shared_ptr<const Manifold::Impl> pImpl_, mat3x4 transform_);
 
   std::shared_ptr<const Manifold::Impl> GetImpl() const;
+  Manifold AsManifold();
 
   std::shared_ptr<CsgLeafNode> ToLeafNode() const override;
 
@@ -84,6 +86,8 @@ class CsgOpNode final : public CsgNode {
   mat3x4 transform_ = la::identity;
   // the following fields are for lazy evaluation, so they are mutable
   mutable std::shared_ptr<CsgLeafNode> cache_ = nullptr;
+
+  static void Finalize(CsgTask &task);
 };
 
 }  // namespace manifold
@@ -12,12 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#if (MANIFOLD_PAR == 1) && __has_include(<tbb/concurrent_map.h>)
+#if (MANIFOLD_PAR == 1) && !defined(MANIFOLD_PAR_NATIVE) && \
+    __has_include(<tbb/concurrent_map.h>)
 #include <tbb/tbb.h>
 #define TBB_PREVIEW_CONCURRENT_ORDERED_CONTAINERS 1
 #include <tbb/concurrent_map.h>
 #endif
-#include <unordered_set>
 
 #include "./impl.h"
 #include "./parallel.h"
@@ -132,10 +132,11 @@ void Manifold::Impl::Face2Tri(const Vec<int>& faceEdge,
                       halfedge_.cbegin() + faceEdge[face + 1], projection);
     return TriangulateIdx(polys, epsilon_);
   };
-#if (MANIFOLD_PAR == 1) && __has_include(<tbb/tbb.h>)
-  tbb::task_group group;
+#if (MANIFOLD_PAR == 1) && \
+    (defined(MANIFOLD_PAR_NATIVE) || __has_include(<tbb/tbb.h>))
+  par::task_group group;
   // map from face to triangle
-  tbb::concurrent_unordered_map<int, std::vector<ivec3>> results;
+  par::concurrent_unordered_map<int, std::vector<ivec3>> results;
   Vec<size_t> triCount(faceEdge.size());
   triCount.back() = 0;
   // precompute number of triangles per face, and launch async tasks to
@@ -226,33 +227,22 @@ PolygonsIdx Manifold::Impl::Face2Polygons(VecView<Halfedge>::IterC start,
   return polys;
 }
 
-Polygons Manifold::Impl::Slice(double height) const {
-  Box plane = bBox_;
-  plane.min.z = plane.max.z = height;
-  Vec<Box> query;
-  query.push_back(plane);
-  const SparseIndices collisions =
-      collider_.Collisions<false, false>(query.cview());
-
-  std::unordered_set<int> tris;
-  for (size_t i = 0; i < collisions.size(); ++i) {
-    const int tri = collisions.Get(i, 1);
-    double min = std::numeric_limits<double>::infinity();
-    double max = -std::numeric_limits<double>::infinity();
-    for (const int j : {0, 1, 2}) {
-      const double z = vertPos_[halfedge_[3 * tri + j].startVert].z;
-      min = std::min(min, z);
-      max = std::max(max, z);
-    }
-
-    if (min <= height && max > height) {
-      tris.insert(tri);
-    }
-  }
+/**
+ * Chains the given triangles, which must be sorted and be exactly those
+ * spanning the height, into the polygons of the cross section there. Each
+ * polygon starts from the lowest-indexed triangle not yet visited, so the
+ * result depends only on the set of triangles.
+ */
+Polygons Manifold::Impl::SliceTris(double height, const Vec<int>& tris) const {
+  std::vector<bool> visited(tris.size(), false);
+  auto index = [&tris](int tri) {
+    return std::lower_bound(tris.begin(), tris.end(), tri) - tris.begin();
+  };
 
   Polygons polys;
-  while (!tris.empty()) {
-    const int startTri = *tris.begin();
+  for (size_t start = 0; start < tris.size(); ++start) {
+    if (visited[start]) continue;
+    const int startTri = tris[start];
     SimplePolygon poly;
 
     int k = 0;
@@ -266,7 +256,7 @@ Polygons Manifold::Impl::Slice(double height) const {
 
     int tri = startTri;
     do {
-      tris.erase(tris.find(tri));
+      visited[index(tri)] = true;
       if (vertPos_[halfedge_[3 * tri + k].endVert].z <= height) {
         k = Next3(k);
       }
@@ -288,76 +278,166 @@ Polygons Manifold::Impl::Slice(double height) const {
   return polys;
 }
 
-std::vector<Polygons> Manifold::Impl::Slices(double bottomZ, double topZ, int nSlices) const {
-    std::vector<Polygons> sections(nSlices);
-    std::vector<float> sliceHeights(nSlices);
-    float step = (topZ - bottomZ) / (nSlices - 1);
+Polygons Manifold::Impl::Slice(double height) const {
+  Box plane = bBox_;
+  plane.min.z = plane.max.z = height;
+  Vec<Box> query;
+  query.push_back(plane);
+  const SparseIndices collisions =
+      collider_.Collisions<false, false>(query.cview());
 
-    for (int i = 0; i < nSlices; ++i) {
-        sliceHeights[i] = bottomZ + i * step;
+  Vec<int> tris;
+  for (size_t i = 0; i < collisions.size(); ++i) {
+    const int tri = collisions.Get(i, 1);
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    for (const int j : {0, 1, 2}) {
+      const double z = vertPos_[halfedge_[3 * tri + j].startVert].z;
+      min = std::min(min, z);
+      max = std::max(max, z);
     }
 
-    std::unordered_map<int, std::unordered_set<int>> sliceToTriangles;
-
-    int numTriangles = halfedge_.size() / 3;
+    if (min <= height && max > height) {
+      tris.push_back(tri);
+    }
+  }
+  std::sort(tris.begin(), tris.end());
 
-    for (int tri = 0; tri < numTriangles; ++tri) {
-        float minZ = std::numeric_limits<float>::infinity();
-        float maxZ = -std::numeric_limits<float>::infinity();
-        for (const int j : {0, 1, 2}) {
-            const float z = vertPos_[halfedge_[3 * tri + j].startVert].z;
-            minZ = std::min(minZ, z);
-            maxZ = std::max(maxZ, z);
-        }
+  return SliceTris(height, tris);
+}
 
-        for (int s = 0; s < nSlices; ++s) {
-            if (minZ <= sliceHeights[s] && maxZ > sliceHeights[s]) {
-                sliceToTriangles[s].insert(tri);
-            }
-        }
-    }
+/**
+ * Passes nSlices evenly spaced cross sections from bottomZ to topZ to the
+ * callback along with their index, each equal to Slice() at that height.
+ * Rather than querying every height, the slices are swept in batches: sorted by
+ * their first slice, triangles join the active set when the sweep reaches them
+ * and leave it once their last slice is passed. Each active triangle emits one
+ * (slice, triangle) event per slice of the batch its Z-range spans; sorting
+ * these groups them by slice, after which the slices are chained in parallel.
+ * Only one batch of events is held at once, so memory is bounded by the
+ * triangles and crossings of a batch rather than of all slices. If ordered,
+ * each batch is passed in order from the calling thread; otherwise the callback
+ * is called from the worker threads as soon as each slice is done.
+ */
+void Manifold::Impl::SliceStream(
+    double bottomZ, double topZ, int nSlices,
+    const std::function<void(int, Polygons)>& callback, bool ordered) const {
+  ZoneScoped;
+  if (nSlices <= 0) return;
+  const double step = nSlices > 1 ? (topZ - bottomZ) / (nSlices - 1) : 0.0;
+  std::vector<double> heights(nSlices);
+  for (int i = 0; i < nSlices; ++i) {
+    heights[i] = bottomZ + i * step;
+  }
 
-    for (int s = 0; s < nSlices; ++s) {
-        float height = sliceHeights[s];
-        std::unordered_set<int>& tris = sliceToTriangles[s];
-        Polygons polys;
-
-        while (!tris.empty()) {
-            const int startTri = *tris.begin();
-            SimplePolygon poly;
-
-            int k = 0;
-            for (const int j : {0, 1, 2}) {
-                if (vertPos_[halfedge_[3 * startTri + j].startVert].z > height &&
-                    vertPos_[halfedge_[3 * startTri + Next3(j)].startVert].z <= height) {
-                    k = Next3(j);
-                    break;
-                }
-            }
+  // The slices satisfying min <= height < max are contiguous whether the
+  // heights ascend or descend.
+  const bool ascending = step >= 0;
+  auto firstSlice = [&](double z) {
+    return static_cast<int>(
+        std::partition_point(
+            heights.begin(), heights.end(),
+            [&](double h) { return ascending ? h < z : h >= z; }) -
+        heights.begin());
+  };
 
-            int tri = startTri;
-            do {
-                tris.erase(tris.find(tri));
-                if (vertPos_[halfedge_[3 * tri + k].endVert].z <= height) {
-                    k = Next3(k);
-                }
-
-                Halfedge up = halfedge_[3 * tri + k];
-                const vec3 below = vertPos_[up.startVert];
-                const vec3 above = vertPos_[up.endVert];
-                const float a = (height - below.z) / (above.z - below.z);
-                poly.push_back(vec2(la::lerp(below, above, a)));
-
-                const int pair = up.pairedHalfedge;
-                tri = pair / 3;
-                k = Next3(pair % 3);
-            } while (tri != startTri);
-
-            polys.push_back(poly);
-        }
+  const int numTri = NumTri();
+  Vec<ivec2> triSlices(numTri);
+  for_each_n(autoPolicy(numTri, 1e4), countAt(0), numTri, [&](const int tri) {
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    for (const int j : {0, 1, 2}) {
+      const double z = vertPos_[halfedge_[3 * tri + j].startVert].z;
+      min = std::min(min, z);
+      max = std::max(max, z);
+    }
+    triSlices[tri] = ascending ? ivec2(firstSlice(min), firstSlice(max))
+                               : ivec2(firstSlice(max), firstSlice(min));
+  });
+  Vec<int> order(numTri);
+  sequence(order.begin(), order.end());
+  stable_sort(order.begin(), order.end(), [&triSlices](int a, int b) {
+    return triSlices[a][0] < triSlices[b][0];
+  });
+
+  constexpr int kBatch = 256;
+  std::vector<Polygons> batch(ordered ? kBatch : 0);
+  Vec<int> active;
+  Vec<int> numEvents;
+  Vec<uint64_t> events;
+  int next = 0;
+  for (int first = 0; first < nSlices; first += kBatch) {
+    const int last = std::min(nSlices, first + kBatch);
+    active.resize(remove_if(active.begin(), active.end(),
+                            [&triSlices, first](int tri) {
+                              return triSlices[tri][1] <= first;
+                            }) -
+                  active.begin());
+    for (; next < numTri && triSlices[order[next]][0] < last; ++next) {
+      const ivec2 range = triSlices[order[next]];
+      if (range[1] > std::max(range[0], first)) active.push_back(order[next]);
+    }
 
-        sections[s] = polys;
+    const int numActive = active.size();
+    numEvents.resize(numActive + 1);
+    numEvents[0] = 0;
+    for_each_n(autoPolicy(numActive, 1e4), countAt(0), numActive,
+               [&](const int i) {
+                 const ivec2 range = triSlices[active[i]];
+                 numEvents[i + 1] = std::max(0, std::min(range[1], last) -
+                                                    std::max(range[0], first));
+               });
+    inclusive_scan(numEvents.begin(), numEvents.end(), numEvents.begin());
+
+    // The slice is in the high bits, so sorting groups events by slice with
+    // the triangles of each slice in ascending order.
+    events.resize(numEvents.back());
+    for_each_n(autoPolicy(numActive, 1e4), countAt(0), numActive,
+               [&](const int i) {
+                 const int tri = active[i];
+                 const int begin = std::max(triSlices[tri][0], first);
+                 for (int s = begin; s < std::min(triSlices[tri][1], last);
+                      ++s) {
+                   events[numEvents[i] + s - begin] =
+                       (static_cast<uint64_t>(s) << 32) |
+                       static_cast<uint32_t>(tri);
+                 }
+               });
+    stable_sort(autoPolicy(events.size(), 1e4), events.begin(), events.end());
+
+    auto slice = [&](const int s) {
+      const auto begin = std::lower_bound(events.begin(), events.end(),
+                                          static_cast<uint64_t>(s) << 32);
+      const auto end = std::lower_bound(begin, events.end(),
+                                        static_cast<uint64_t>(s + 1) << 32);
+      Vec<int> tris(end - begin);
+      for (auto it = begin; it != end; ++it) {
+        tris[it - begin] = static_cast<int>(*it & 0xffffffff);
+      }
+      return SliceTris(heights[s], tris);
+    };
+
+    const int size = last - first;
+    if (!ordered) {
+      for_each_n(autoPolicy(size, 4), countAt(first), size,
+                 [&](const int s) { callback(s, slice(s)); });
+      continue;
     }
+    for_each_n(autoPolicy(size, 4), countAt(0), size,
+               [&](const int i) { batch[i] = slice(first + i); });
+    for (int i = 0; i < size; ++i) {
+      callback(first + i, std::move(batch[i]));
+    }
+  }
+}
+
+std::vector<Polygons> Manifold::Impl::Slices(double bottomZ, double topZ,
+                                             int nSlices) const {
+  std::vector<Polygons> sections(std::max(0, nSlices));
+  SliceStream(
+      bottomZ, topZ, nSlices,
+      [&sections](int s, Polygons polys) { sections[s] = std::move(polys); },
+      false);
   return sections;
 }
 
@@ -389,4 +469,376 @@ Polygons Manifold::Impl::Project() const {
 
   return polys;
 }
+
+/**
+ * The classification of this manifold against a plane, which is shared by both
+ * sides of a split: which side of the plane each vert is on, and a new vert on
+ * each forward edge whose ends are on different sides, with its interpolated
+ * properties. A side only uses the new verts on the edges it cuts, since an
+ * edge from a vert on the plane is only cut by the side it leaves the plane
+ * towards.
+ */
+struct Manifold::Impl::PlaneCut {
+  vec3 normal;
+  // 1 where dot(normal, x) > originOffset, -1 where it is less and 0 on the
+  // plane.
+  Vec<int> side;
+  // The new vert of each forward halfedge that crosses the plane, by an
+  // exclusive scan.
+  Vec<int> edgeNewVert;
+  // The forward halfedge each new vert lies on.
+  Vec<int> newVertEdge;
+  Vec<double> newVertLambda;
+  Vec<vec3> newVertPos;
+  // Each new vert gets one property vert interpolated along its edge, or two
+  // if the edge is a property seam. These index newProperties by an exclusive
+  // scan.
+  Vec<int> newVertProp;
+  Vec<double> newProperties;
+};
+
+Manifold::Impl::PlaneCut Manifold::Impl::ClassifyByPlane(
+    vec3 normal, double originOffset) const {
+  ZoneScoped;
+  const int numVert = NumVert();
+  const int numHalfedge = halfedge_.size();
+
+  PlaneCut cut;
+  cut.normal = la::normalize(normal);
+  Vec<double> dist(numVert);
+  cut.side.resize(numVert);
+  for_each_n(autoPolicy(numVert, 1e4), countAt(0), numVert,
+             [&](const int vert) {
+               dist[vert] = la::dot(cut.normal, vertPos_[vert]) - originOffset;
+               cut.side[vert] = dist[vert] > 0 ? 1 : dist[vert] < 0 ? -1 : 0;
+             });
+
+  Vec<int> crossing(numHalfedge);
+  for_each_n(autoPolicy(numHalfedge, 1e4), countAt(0), numHalfedge,
+             [&](const int edge) {
+               const Halfedge halfedge = halfedge_[edge];
+               crossing[edge] = halfedge.IsForward() &&
+                                cut.side[halfedge.startVert] !=
+                                    cut.side[halfedge.endVert];
+             });
+  cut.edgeNewVert.resize(numHalfedge + 1, 0);
+  inclusive_scan(crossing.begin(), crossing.end(),
+                 cut.edgeNewVert.begin() + 1);
+  const int numNew = cut.edgeNewVert.back();
+
+  cut.newVertEdge.resize(numNew);
+  cut.newVertLambda.resize(numNew);
+  cut.newVertPos.resize(numNew);
+  for_each_n(autoPolicy(numHalfedge, 1e4), countAt(0), numHalfedge,
+             [&](const int edge) {
+               if (!crossing[edge]) return;
+               const Halfedge halfedge = halfedge_[edge];
+               const double d0 = dist[halfedge.startVert];
+               const double d1 = dist[halfedge.endVert];
+               const double lambda = d0 / (d0 - d1);
+               const int newVert = cut.edgeNewVert[edge];
+               cut.newVertEdge[newVert] = edge;
+               cut.newVertLambda[newVert] = lambda;
+               cut.newVertPos[newVert] =
+                   la::lerp(vertPos_[halfedge.startVert],
+                            vertPos_[halfedge.endVert], lambda);
+             });
+
+  const int numProp = NumProp();
+  if (numProp == 0) return cut;
+
+  const ivec3* triProp = meshRelation_.triProperties.data();
+  Vec<int> propsPerNewVert(numNew);
+  for_each_n(autoPolicy(numNew, 1e4), countAt(0), numNew,
+             [&](const int newVert) {
+               const int edge = cut.newVertEdge[newVert];
+               const int pair = halfedge_[edge].pairedHalfedge;
+               const bool seam = triProp[edge / 3][edge % 3] !=
+                                     triProp[pair / 3][Next3(pair % 3)] ||
+                                 triProp[edge / 3][Next3(edge % 3)] !=
+                                     triProp[pair / 3][pair % 3];
+               propsPerNewVert[newVert] = seam ? 2 : 1;
+             });
+  cut.newVertProp.resize(numNew + 1, 0);
+  inclusive_scan(propsPerNewVert.begin(), propsPerNewVert.end(),
+                 cut.newVertProp.begin() + 1);
+
+  cut.newProperties.resize(numProp * cut.newVertProp.back());
+  auto interpolate = [&](const int edge, const int propVert,
+                         const double lambda) {
+    const int i = edge % 3;
+    const int p0 = triProp[edge / 3][i];
+    const int p1 = triProp[edge / 3][Next3(i)];
+    for (int p = 0; p < numProp; ++p)
+      cut.newProperties[numProp * propVert + p] =
+          la::lerp(meshRelation_.properties[numProp * p0 + p],
+                   meshRelation_.properties[numProp * p1 + p], lambda);
+  };
+  for_each_n(autoPolicy(numNew, 1e4), countAt(0), numNew,
+             [&](const int newVert) {
+               const int edge = cut.newVertEdge[newVert];
+               const int propVert = cut.newVertProp[newVert];
+               const double lambda = cut.newVertLambda[newVert];
+               interpolate(edge, propVert, lambda);
+               if (propsPerNewVert[newVert] == 2)
+                 interpolate(halfedge_[edge].pairedHalfedge, propVert + 1,
+                             1 - lambda);
+             });
+  return cut;
+}
+
+/**
+ * Returns the part of this manifold where dot(normal, x) > originOffset, with
+ * the cut closed by a new planar face. Since the cutter is a plane, every
+ * intersection is a single crossing of an edge, so this needs neither the
+ * collider nor winding numbers, and every step but the triangulation of the
+ * cap is a parallel map over verts, edges or triangles. Verts exactly on the
+ * plane are treated as outside, so both sides of a split are handled the same
+ * way. The cap references a new OriginalID, as if it came from a half-space
+ * cutter.
+ */
+Manifold::Impl Manifold::Impl::CutByPlane(vec3 normal,
+                                          double originOffset) const {
+  if (status_ != Error::NoError) {
+    Impl impl;
+    impl.status_ = status_;
+    return impl;
+  }
+  if (IsEmpty()) return Impl();
+  return CutByPlane(ClassifyByPlane(normal, originOffset), true);
+}
+
+/**
+ * Returns both sides of CutByPlane, the first in the direction of normal,
+ * classifying the manifold against the plane only once and building the two
+ * sides in parallel.
+ */
+std::pair<Manifold::Impl, Manifold::Impl> Manifold::Impl::SplitByPlane(
+    vec3 normal, double originOffset) const {
+  if (status_ != Error::NoError) {
+    Impl impl;
+    impl.status_ = status_;
+    return {impl, impl};
+  }
+  if (IsEmpty()) return {Impl(), Impl()};
+  const PlaneCut cut = ClassifyByPlane(normal, originOffset);
+  std::pair<Impl, Impl> sides;
+  auto cutPositive = [&]() { sides.first = CutByPlane(cut, true); };
+  auto cutNegative = [&]() { sides.second = CutByPlane(cut, false); };
+#if (MANIFOLD_PAR == 1)
+  // The sides only share the classification, and parts of each, such as
+  // triangulating the cap, are sequential.
+  if (autoPolicy(NumTri(), 1e4) == ExecutionPolicy::Par) {
+    par::parallel_invoke(cutPositive, cutNegative);
+    return sides;
+  }
+#endif
+  cutPositive();
+  cutNegative();
+  return sides;
+}
+
+/**
+ * Returns the side of the classified plane cut that is in the direction of its
+ * normal if positive, or the opposite side otherwise.
+ */
+Manifold::Impl Manifold::Impl::CutByPlane(const PlaneCut& cut,
+                                          bool positive) const {
+  ZoneScoped;
+  const int numVert = NumVert();
+  const int numHalfedge = halfedge_.size();
+  const int numTri = NumTri();
+  const int keep = positive ? 1 : -1;
+  auto inside = [&](const int vert) { return cut.side[vert] == keep; };
+
+  auto insideIter = TransformIterator(
+      cut.side.begin(), [keep](int side) { return side == keep ? 1 : 0; });
+  Vec<int> vertOld2New(numVert + 1, 0);
+  inclusive_scan(insideIter, insideIter + numVert, vertOld2New.begin() + 1);
+  const int numKept = vertOld2New.back();
+  if (numKept == 0) return Impl();
+  if (numKept == numVert) return *this;
+
+  // The new verts are shared by both sides, and those on edges this side
+  // doesn't cut are removed with the other unreferenced verts.
+  const int numNew = cut.newVertPos.size();
+  Impl outR;
+  outR.epsilon_ = epsilon_;
+  outR.tolerance_ = tolerance_;
+  outR.vertPos_.resize(numKept + numNew);
+  Vec<int> vertNew2Old(numKept);
+  for_each_n(autoPolicy(numVert, 1e4), countAt(0), numVert,
+             [&](const int vert) {
+               if (!inside(vert)) return;
+               outR.vertPos_[vertOld2New[vert]] = vertPos_[vert];
+               vertNew2Old[vertOld2New[vert]] = vert;
+             });
+  copy(cut.newVertPos.begin(), cut.newVertPos.end(),
+       outR.vertPos_.begin() + numKept);
+  auto vertR = [&](const int edge, const bool start) {
+    const Halfedge halfedge = halfedge_[edge];
+    const int vert = start ? halfedge.startVert : halfedge.endVert;
+    if (inside(vert)) return vertOld2New[vert];
+    const int forward = halfedge.IsForward() ? edge : halfedge.pairedHalfedge;
+    return numKept + cut.edgeNewVert[forward];
+  };
+
+  // Kept triangles stay whole, while clipped ones become a triangle or a quad
+  // that includes one cut edge along the plane.
+  Vec<int> sidesPerTri(numTri);
+  Vec<int> cutTri(numTri);
+  for_each_n(autoPolicy(numTri, 1e4), countAt(0), numTri, [&](const int tri) {
+    int numIn = 0;
+    for (const int i : {0, 1, 2})
+      numIn += inside(halfedge_[3 * tri + i].startVert);
+    sidesPerTri[tri] = numIn == 0 ? 0 : numIn == 3 ? 3 : numIn + 2;
+    cutTri[tri] = numIn == 1 || numIn == 2;
+  });
+
+  Vec<int> triEdge(numTri + 1, 0);
+  inclusive_scan(sidesPerTri.begin(), sidesPerTri.end(), triEdge.begin() + 1);
+  Vec<int> triCut(numTri + 1, 0);
+  inclusive_scan(cutTri.begin(), cutTri.end(), triCut.begin() + 1);
+  auto keepTri = TransformIterator(sidesPerTri.begin(),
+                                   [](int x) { return x > 0 ? 1 : 0; });
+  Vec<int> triOld2Face(numTri + 1, 0);
+  inclusive_scan(keepTri, keepTri + numTri, triOld2Face.begin() + 1);
+  const int numFace = triOld2Face.back();
+  const int numCut = triCut.back();
+  const int capEdge = triEdge.back();
+
+  // The cap is the last face, made of the reversed cut edges.
+  const int numCap = numCut > 0 ? 1 : 0;
+  Vec<int> faceEdge(numFace + numCap + 1);
+  faceEdge[numFace] = capEdge;
+  faceEdge.back() = capEdge + numCut;
+  outR.faceNormal_.resize(numFace + numCap);
+  if (numCap > 0)
+    outR.faceNormal_[numFace] = positive ? -cut.normal : cut.normal;
+  outR.halfedge_.resize(capEdge + numCut);
+  // The tri here is local until the properties are built, and meshID marks the
+  // cap.
+  Vec<TriRef> halfedgeRef(outR.halfedge_.size(), {1, -1, 0});
+  Vec<int> halfedgeOld2New(numHalfedge, -1);
+
+  for_each_n(autoPolicy(numTri, 1e4), countAt(0), numTri, [&](const int tri) {
+    if (sidesPerTri[tri] == 0) return;
+    const int face = triOld2Face[tri];
+    faceEdge[face] = triEdge[tri];
+    outR.faceNormal_[face] = faceNormal_[tri];
+    const TriRef ref = {0, -1, tri};
+
+    int entry = -1;
+    for (const int i : {0, 1, 2}) {
+      const Halfedge halfedge = halfedge_[3 * tri + i];
+      if (!inside(halfedge.startVert) && inside(halfedge.endVert))
+        entry = 3 * tri + i;
+    }
+
+    int next = triEdge[tri];
+    for (const int i : {0, 1, 2}) {
+      const int edge = 3 * tri + i;
+      const Halfedge halfedge = halfedge_[edge];
+      const bool startIn = inside(halfedge.startVert);
+      const bool endIn = inside(halfedge.endVert);
+      if (!startIn && !endIn) continue;
+
+      halfedgeOld2New[edge] = next;
+      halfedgeRef[next] = ref;
+      outR.halfedge_[next++] = {vertR(edge, true), vertR(edge, false), -1};
+      if (!startIn || endIn) continue;
+
+      const int cap = capEdge + triCut[tri];
+      const int exitVert = vertR(edge, false);
+      const int entryVert = vertR(entry, true);
+      halfedgeRef[next] = ref;
+      outR.halfedge_[next] = {exitVert, entryVert, cap};
+      outR.halfedge_[cap] = {entryVert, exitVert, next++};
+    }
+  });
+
+  for_each_n(autoPolicy(numHalfedge, 1e4), countAt(0), numHalfedge,
+             [&](const int edge) {
+               const int newEdge = halfedgeOld2New[edge];
+               if (newEdge < 0) return;
+               outR.halfedge_[newEdge].pairedHalfedge =
+                   halfedgeOld2New[halfedge_[edge].pairedHalfedge];
+             });
+
+  if (ManifoldParams().intermediateChecks)
+    DEBUG_ASSERT(outR.IsManifold(), logicErr, "polygon mesh is not manifold!");
+
+  outR.Face2Tri(faceEdge, halfedgeRef);
+
+  if (ManifoldParams().intermediateChecks)
+    DEBUG_ASSERT(outR.IsManifold(), logicErr,
+                 "triangulated mesh is not manifold!");
+
+  const int numProp = NumProp();
+  const int numTriR = outR.NumTri();
+  if (numProp > 0) {
+    const ivec3* triProp = meshRelation_.triProperties.data();
+    const int numPropVert = NumPropVert();
+    const int capProp = numPropVert + cut.newVertProp.back();
+
+    // The cap shares a single zero property vert, as it has no properties of
+    // its own.
+    outR.meshRelation_.numProp = numProp;
+    auto& properties = outR.meshRelation_.properties;
+    properties.resize(numProp * (capProp + 1), 0);
+    copy(meshRelation_.properties.begin(), meshRelation_.properties.end(),
+         properties.begin());
+    copy(cut.newProperties.begin(), cut.newProperties.end(),
+         properties.begin() + numProp * numPropVert);
+
+    outR.meshRelation_.triProperties.resize(numTriR);
+    for_each_n(
+        autoPolicy(numTriR, 1e4), countAt(0), numTriR, [&](const int tri) {
+          const TriRef ref = outR.meshRelation_.triRef[tri];
+          for (const int i : {0, 1, 2}) {
+            int& prop = outR.meshRelation_.triProperties[tri][i];
+            if (ref.meshID == 1) {
+              prop = capProp;
+              continue;
+            }
+            const int vert = outR.halfedge_[3 * tri + i].startVert;
+            if (vert < numKept) {
+              const int oldVert = vertNew2Old[vert];
+              for (const int j : {0, 1, 2}) {
+                if (halfedge_[3 * ref.tri + j].startVert == oldVert)
+                  prop = triProp[ref.tri][j];
+              }
+            } else {
+              const int newVert = vert - numKept;
+              const int edge = cut.newVertEdge[newVert];
+              // The second property vert of a seam belongs to the paired
+              // edge's triangle.
+              prop = numPropVert + (edge / 3 == ref.tri
+                                        ? cut.newVertProp[newVert]
+                                        : cut.newVertProp[newVert + 1] - 1);
+            }
+          }
+        });
+  }
+
+  const int capID = ReserveIDs(1);
+  const TriRef capRef = {capID, capID, 0, 0};
+  for_each_n(autoPolicy(numTriR, 1e5), outR.meshRelation_.triRef.begin(),
+             numTriR, [&](TriRef& ref) {
+               ref = ref.meshID == 1 ? capRef : meshRelation_.triRef[ref.tri];
+             });
+  outR.meshRelation_.meshIDtransform = meshRelation_.meshIDtransform;
+  outR.meshRelation_.meshIDtransform[capID] = {capID};
+
+  outR.SimplifyTopology();
+  outR.RemoveUnreferencedVerts();
+
+  if (ManifoldParams().intermediateChecks)
+    DEBUG_ASSERT(outR.Is2Manifold(), logicErr,
+                 "simplified mesh is not 2-manifold!");
+
+  outR.Finish();
+  outR.IncrementMeshIDs();
+  return outR;
+}
 }  // namespace manifold
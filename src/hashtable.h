@@ -70,18 +70,20 @@ class HashTableD {
            static_cast<size_t>(Size());
   }
 
-  void Insert(Uint64 key, const V& val) {
+  // Returns false if the table is full, in which case the key was not
+  // inserted; reserve room beforehand with HashTable::Reserve to avoid this.
+  bool Insert(Uint64 key, const V& val) {
     uint32_t idx = H(key) & (Size() - 1);
     while (1) {
-      if (Full()) return;
+      if (Full()) return false;
       Uint64& k = keys_[idx];
       const Uint64 found = AtomicCAS(k, kOpen, key);
       if (found == kOpen) {
         used_.fetch_add(1, std::memory_order_relaxed);
         values_[idx] = val;
-        return;
+        return true;
       }
-      if (found == key) return;
+      if (found == key) return true;
       idx = (idx + step_) & (Size() - 1);
     }
   }
@@ -119,6 +121,19 @@ class HashTableD {
   std::atomic<size_t>& used_;
 };
 
+/**
+ * Occupancy and probe-length statistics of a HashTable, for tuning its size and
+ * hash function. A probe length is the number of steps from a key's hashed
+ * slot to where it was stored.
+ */
+struct HashTableStats {
+  size_t entries = 0;
+  size_t capacity = 0;
+  double loadFactor = 0;
+  int maxProbe = 0;
+  double meanProbe = 0;
+};
+
 template <typename V, hash_fun_t H = hash64bit>
 class HashTable {
  public:
@@ -155,6 +170,52 @@ class HashTable {
     return static_cast<double>(used_.load(std::memory_order_relaxed)) / Size();
   }
 
+  // Number of entries that are guaranteed to fit before the table is Full().
+  size_t Room() const {
+    const size_t used = used_.load(std::memory_order_relaxed);
+    return Size() / 2 > used ? Size() / 2 - used : 0;
+  }
+
+  // Grows the table, if needed, so that at least room more entries fit,
+  // migrating the current entries in parallel. This must not run concurrently
+  // with any HashTableD of this table.
+  void Reserve(size_t room) {
+    const size_t entries = used_.load(std::memory_order_relaxed) + room;
+    if (2 * entries <= Size()) return;
+    HashTable<V, H> bigger(2 * entries + 1, step_);
+    HashTableD<V, H> dest = bigger.D();
+    for_each_n(autoPolicy(Size(), 1e5), countAt(0_uz), Size(),
+               [this, &dest](size_t i) {
+                 if (keys_[i] != kOpen) dest.Insert(keys_[i], values_[i]);
+               });
+    keys_.swap(bigger.keys_);
+    values_.swap(bigger.values_);
+    used_.store(bigger.used_.load());
+  }
+
+  HashTableStats Stats() const {
+    HashTableStats stats;
+    stats.capacity = Size();
+    stats.entries = used_.load(std::memory_order_relaxed);
+    stats.loadFactor = FilledFraction();
+    size_t totalProbe = 0;
+    for (size_t i = 0; i < Size(); ++i) {
+      if (keys_[i] == kOpen) continue;
+      // Probes from the hashed slot wrap around the power-of-two table.
+      size_t idx = H(keys_[i]) & (Size() - 1);
+      int probe = 0;
+      while (idx != i) {
+        idx = (idx + step_) & (Size() - 1);
+        ++probe;
+      }
+      stats.maxProbe = std::max(stats.maxProbe, probe);
+      totalProbe += probe;
+    }
+    if (stats.entries > 0)
+      stats.meanProbe = static_cast<double>(totalProbe) / stats.entries;
+    return stats;
+  }
+
   Vec<V>& GetValueStore() { return values_; }
 
   static Uint64 Open() { return kOpen; }
@@ -287,6 +287,16 @@ struct Manifold::Impl {
   bool MatchesTriNormals() const;
   int NumDegenerateTris() const;
   double MinGap(const Impl& other, double searchLength) const;
+  double MinGap(const Impl& other, double searchLength,
+                const mat3x4& transform) const;
+  bool Overlaps(const Impl& other, const mat3x4& transform) const;
+  size_t NumEdgeOverlaps(const Impl& other, const mat3x4& transform) const;
+  int WindingNumber(vec3 point) const;
+  int NearestTri(vec3 point, double& dist2) const;
+  double Distance(vec3 point, double maxDistance) const;
+  SurfacePoint ClosestPoint(vec3 point, double maxDistance) const;
+  double SignedDistance(vec3 point, double maxDistance) const;
+  RayHit RayCast(vec3 origin, vec3 direction) const;
 
   // sort.cpp
   void Finish();
@@ -303,9 +313,18 @@ struct Manifold::Impl {
   PolygonsIdx Face2Polygons(VecView<Halfedge>::IterC start,
                             VecView<Halfedge>::IterC end,
                             mat2x3 projection) const;
+  Polygons SliceTris(double height, const Vec<int>& tris) const;
   Polygons Slice(double height) const;
+  void SliceStream(double bottomZ, double topZ, int nSlices,
+                   const std::function<void(int, Polygons)>& callback,
+                   bool ordered) const;
   std::vector<Polygons> Slices(double bottomZ, double topZ, int nSlices) const;
   Polygons Project() const;
+  struct PlaneCut;
+  PlaneCut ClassifyByPlane(vec3 normal, double originOffset) const;
+  Impl CutByPlane(vec3 normal, double originOffset) const;
+  Impl CutByPlane(const PlaneCut& cut, bool positive) const;
+  std::pair<Impl, Impl> SplitByPlane(vec3 normal, double originOffset) const;
 
   // edge_op.cpp
   void CleanupTopology();
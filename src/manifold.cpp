@@ -46,17 +46,6 @@ struct UpdateProperties {
   }
 };
 
-Manifold Halfspace(Box bBox, vec3 normal, double originOffset) {
-  normal = la::normalize(normal);
-  Manifold cutter = Manifold::Cube(vec3(2.0), true).Translate({1.0, 0.0, 0.0});
-  double size = la::length(bBox.Center() - normal * originOffset) +
-                0.5 * la::length(bBox.Size());
-  cutter = cutter.Scale(vec3(size)).Translate({originOffset, 0.0, 0.0});
-  double yDeg = degrees(-std::asin(normal.z));
-  double zDeg = degrees(std::atan2(normal.y, normal.x));
-  return cutter.Rotate(0.0, yDeg, zDeg);
-}
-
 template <typename Precision, typename I>
 MeshGLP<Precision, I> GetMeshGLImpl(const manifold::Manifold::Impl& impl,
                                     int normalIdx) {
@@ -513,6 +502,21 @@ size_t Manifold::NumOverlaps(const Manifold& other) const {
   return num_overlaps + overlaps.size();
 }
 
+/**
+ * As above, but with other moved by transform, without creating the
+ * transformed copy of other that Transform() would. This returns the same
+ * count as NumOverlaps(other.Transform(otherTransform)), including for a
+ * singular transform that flattens other.
+ *
+ * @param other A Manifold to overlap with.
+ * @param otherTransform The transform applied to other.
+ */
+size_t Manifold::NumOverlaps(const Manifold& other,
+                             const mat3x4& otherTransform) const {
+  return GetCsgLeafNode().GetImpl()->NumEdgeOverlaps(
+      *other.GetCsgLeafNode().GetImpl(), otherTransform);
+}
+
 /**
  * Move this Manifold in space. This operation can be chained. Transforms are
  * combined and applied lazily.
@@ -952,7 +956,13 @@ std::pair<Manifold, Manifold> Manifold::Split(const Manifold& cutter) const {
  */
 std::pair<Manifold, Manifold> Manifold::SplitByPlane(
     vec3 normal, double originOffset) const {
-  return Split(Halfspace(BoundingBox(), normal, originOffset));
+  auto [impl1, impl2] =
+      GetCsgLeafNode().GetImpl()->SplitByPlane(normal, originOffset);
+  auto result1 =
+      std::make_shared<CsgLeafNode>(std::make_unique<Impl>(std::move(impl1)));
+  auto result2 =
+      std::make_shared<CsgLeafNode>(std::make_unique<Impl>(std::move(impl2)));
+  return std::make_pair(Manifold(result1), Manifold(result2));
 }
 
 /**
@@ -965,7 +975,9 @@ std::pair<Manifold, Manifold> Manifold::SplitByPlane(
  * direction of the normal vector.
  */
 Manifold Manifold::TrimByPlane(vec3 normal, double originOffset) const {
-  return *this ^ Halfspace(BoundingBox(), normal, originOffset);
+  auto impl = GetCsgLeafNode().GetImpl();
+  return Manifold(std::make_shared<CsgLeafNode>(
+      std::make_unique<Impl>(impl->CutByPlane(normal, originOffset))));
 }
 
 /**
@@ -978,9 +990,34 @@ Polygons Manifold::Slice(double height) const {
   return GetCsgLeafNode().GetImpl()->Slice(height);
 }
 
-std::vector<Polygons> Manifold::Slices(double bottomZ, double topZ, int nSlices) const {
+/**
+ * Returns nSlices cross sections evenly spaced from bottomZ to topZ inclusive,
+ * each identical to Slice() at that height. This is much faster than calling
+ * Slice() repeatedly, as each triangle is only visited by the slices it spans.
+ */
+std::vector<Polygons> Manifold::Slices(double bottomZ, double topZ,
+                                       int nSlices) const {
   return GetCsgLeafNode().GetImpl()->Slices(bottomZ, topZ, nSlices);
+}
 
+/**
+ * Computes the same cross sections as Slices(), but hands each one to the
+ * callback with its index as soon as it is ready instead of returning them all
+ * at once, so very large jobs need not hold every layer in memory.
+ *
+ * @param bottomZ The height of the first slice.
+ * @param topZ The height of the last slice.
+ * @param nSlices The number of evenly spaced slices.
+ * @param callback Called once per slice with its index and polygons.
+ * @param ordered If true (default), the callback is called from the calling
+ * thread in order of increasing index. Otherwise it may be called concurrently
+ * from worker threads in any order, so it must be thread-safe.
+ */
+void Manifold::SliceStream(double bottomZ, double topZ, int nSlices,
+                           std::function<void(int, Polygons)> callback,
+                           bool ordered) const {
+  GetCsgLeafNode().GetImpl()->SliceStream(bottomZ, topZ, nSlices, callback,
+                                          ordered);
 }
 
 /**
@@ -995,6 +1032,12 @@ Polygons Manifold::Project() const {
 
 ExecutionParams& ManifoldParams() { return manifoldParams; }
 
+void SetExecutor(std::shared_ptr<Executor> executor) {
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+  pool::ThreadPool::Get().SetExecutor(std::move(executor));
+#endif
+}
+
 /**
  * Compute the convex hull of a set of points. If the given points are fewer
  * than 4, or they are all coplanar, an empty Manifold will be returned.
@@ -1108,10 +1151,251 @@ Manifold Manifold::Hull(const std::vector<Manifold>& manifolds) {
  * @param searchLength The maximum distance to search for a minimum gap.
  */
 double Manifold::MinGap(const Manifold& other, double searchLength) const {
-  auto intersect = *this ^ other;
-  if (!intersect.IsEmpty()) return 0.0;
+  if (Overlaps(other)) return 0.0;
 
   return GetCsgLeafNode().GetImpl()->MinGap(*other.GetCsgLeafNode().GetImpl(),
                                             searchLength);
 }
+
+/**
+ * Returns true if the two manifolds share any point, including where their
+ * surfaces only touch. This is much faster than checking whether their
+ * intersection is empty, since it stops at the first contact and builds no
+ * mesh.
+ *
+ * @param other The other manifold to test against.
+ */
+bool Manifold::Overlaps(const Manifold& other) const {
+  return Overlaps(other, la::identity);
+}
+
+/**
+ * As above, but with other moved by a rigid or affine transform, without
+ * creating the transformed copy of other that Transform() would. This is meant
+ * for testing the same pair of manifolds at many relative poses. A singular
+ * transform is allowed and tests the flattened copy of other, which contains
+ * no volume of its own.
+ *
+ * @param other The other manifold to test against.
+ * @param otherTransform The transform applied to other.
+ */
+bool Manifold::Overlaps(const Manifold& other,
+                        const mat3x4& otherTransform) const {
+  return GetCsgLeafNode().GetImpl()->Overlaps(
+      *other.GetCsgLeafNode().GetImpl(), otherTransform);
+}
+
+/**
+ * Returns the minimum gap between this and other moved by a rigid or affine
+ * transform, without creating the transformed copy of other that Transform()
+ * would. Returns a double between 0 and searchLength. This is meant for
+ * clearance checks of the same pair of manifolds at many relative poses. As
+ * with Overlaps, a singular transform measures to the flattened copy of other.
+ *
+ * @param other The other manifold to compute the minimum gap to.
+ * @param searchLength The maximum distance to search for a minimum gap.
+ * @param otherTransform The transform applied to other.
+ */
+double Manifold::MinGap(const Manifold& other, double searchLength,
+                        const mat3x4& otherTransform) const {
+  if (Overlaps(other, otherTransform)) return 0.0;
+
+  return GetCsgLeafNode().GetImpl()->MinGap(*other.GetCsgLeafNode().GetImpl(),
+                                            searchLength, otherTransform);
+}
+
+/**
+ * Finds every pair of the input manifolds that overlap or whose gap is less
+ * than clearance, as a sparse list sorted by index. Candidate pairs are found
+ * by a Collider over the parts' bounding boxes, so this scales with the number
+ * of nearby pairs rather than the square of the number of parts, which makes
+ * it suitable for checking large assemblies. Each candidate is then checked
+ * with Overlaps and MinGap, in parallel.
+ *
+ * @param manifolds The parts to check against each other.
+ * @param clearance Pairs closer than this are reported along with their gap.
+ * The default of 0 reports only overlapping pairs.
+ */
+std::vector<Interference> Manifold::PairwiseOverlaps(
+    const std::vector<Manifold>& manifolds, double clearance) {
+  ZoneScoped;
+  clearance = std::max(clearance, 0.0);
+  std::vector<std::shared_ptr<const Impl>> parts;
+  Vec<size_t> part2Input;
+  for (size_t i = 0; i < manifolds.size(); ++i) {
+    auto impl = manifolds[i].GetCsgLeafNode().GetImpl();
+    if (impl->IsEmpty()) continue;
+    parts.push_back(impl);
+    part2Input.push_back(i);
+  }
+  const size_t numPart = parts.size();
+  if (numPart < 2) return {};
+
+  // Expanding each box by half the clearance makes the boxes of any pair
+  // closer than clearance overlap.
+  Vec<Box> boxes(numPart);
+  Box bounds;
+  for (size_t i = 0; i < numPart; ++i) {
+    boxes[i] = Box(parts[i]->bBox_.min - vec3(clearance / 2),
+                   parts[i]->bBox_.max + vec3(clearance / 2));
+    bounds = bounds.Union(boxes[i]);
+  }
+  Vec<uint32_t> morton(numPart);
+  for_each_n(autoPolicy(numPart, 1e4), countAt(0_uz), numPart,
+             [&morton, &boxes, &bounds](size_t i) {
+               morton[i] = Collider::MortonCode(boxes[i].Center(), bounds);
+             });
+  Vec<size_t> new2Old(numPart);
+  sequence(new2Old.begin(), new2Old.end());
+  stable_sort(new2Old.begin(), new2Old.end(),
+              [&morton](const size_t a, const size_t b) {
+                return morton[a] < morton[b];
+              });
+  Permute(morton, new2Old);
+  Permute(boxes, new2Old);
+  Permute(parts, new2Old);
+  Permute(part2Input, new2Old);
+
+  // Self-collision records each overlapping pair in both directions, so keep
+  // only one.
+  const SparseIndices collisions =
+      Collider(boxes, morton).Collisions<true>(boxes.cview());
+  Vec<std::pair<int, int>> candidates;
+  for (size_t i = 0; i < collisions.size(); ++i) {
+    const int a = collisions.Get(i, false);
+    const int b = collisions.Get(i, true);
+    if (a < b) candidates.push_back({a, b});
+  }
+
+  const size_t numCandidate = candidates.size();
+  Vec<double> gap(numCandidate);
+  for_each_n(autoPolicy(numCandidate, 1e2), countAt(0_uz), numCandidate,
+             [&](size_t i) {
+               const Impl& a = *parts[candidates[i].first];
+               const Impl& b = *parts[candidates[i].second];
+               if (a.Overlaps(b, la::identity)) {
+                 gap[i] = 0;
+               } else if (clearance > 0) {
+                 gap[i] = a.MinGap(b, clearance, la::identity);
+               } else {
+                 gap[i] = std::numeric_limits<double>::infinity();
+               }
+             });
+
+  std::vector<Interference> result;
+  for (size_t i = 0; i < numCandidate; ++i) {
+    if (gap[i] > 0 && gap[i] >= clearance) continue;
+    size_t first = part2Input[candidates[i].first];
+    size_t second = part2Input[candidates[i].second];
+    if (first > second) std::swap(first, second);
+    result.push_back({first, second, gap[i]});
+  }
+  std::sort(result.begin(), result.end(),
+            [](const Interference& a, const Interference& b) {
+              return a.first != b.first ? a.first < b.first
+                                        : a.second < b.second;
+            });
+  return result;
+}
+
+/**
+ * Returns the signed distance from a point to the surface of this manifold,
+ * positive inside and negative outside, the same convention as the sdf of
+ * LevelSet, so the result can be offset, shelled or blended and meshed again.
+ *
+ * @param point The query point.
+ * @param maxDistance Distances are clamped to +/- this value, which allows
+ * faster queries when only a band around the surface matters.
+ */
+double Manifold::SignedDistance(vec3 point, double maxDistance) const {
+  return GetCsgLeafNode().GetImpl()->SignedDistance(point, maxDistance);
+}
+
+/**
+ * Batch version of SignedDistance, which evaluates the points in parallel.
+ * The signature matches the sdf of LevelSetBatch.
+ *
+ * @param points The query points.
+ * @param distances Output of the same length as points.
+ * @param maxDistance Distances are clamped to +/- this value, which allows
+ * faster queries when only a band around the surface matters.
+ */
+void Manifold::SignedDistance(VecView<const vec3> points,
+                              VecView<double> distances,
+                              double maxDistance) const {
+  DEBUG_ASSERT(points.size() == distances.size(), userErr,
+               "points and distances must be the same length");
+  const auto impl = GetCsgLeafNode().GetImpl();
+  for_each_n(autoPolicy(points.size(), 1e3), countAt(0_uz), points.size(),
+             [&](size_t i) {
+               distances[i] = impl->SignedDistance(points[i], maxDistance);
+             });
+}
+
+/**
+ * Casts a batch of rays in parallel, returning the first hit of each along its
+ * direction beyond its origin. Adjacent triangles share edges exactly in the
+ * intersection test, so a ray can't slip through the surface between them.
+ *
+ * @param origins The start of each ray.
+ * @param directions The direction of each ray, of the same length as origins.
+ * Hit distances are in units of each direction's length.
+ */
+std::vector<RayHit> Manifold::RayCast(VecView<const vec3> origins,
+                                      VecView<const vec3> directions) const {
+  DEBUG_ASSERT(origins.size() == directions.size(), userErr,
+               "origins and directions must be the same length");
+  const auto impl = GetCsgLeafNode().GetImpl();
+  std::vector<RayHit> hits(origins.size());
+  for_each_n(autoPolicy(origins.size(), 1e3), countAt(0_uz), origins.size(),
+             [&](size_t i) {
+               hits[i] = impl->RayCast(origins[i], directions[i]);
+             });
+  return hits;
+}
+
+/**
+ * Classifies a batch of points in parallel as inside, outside, or on the
+ * surface, meaning within GetTolerance() of it. Inside and outside are
+ * decided by the parity of crossings along a ray, so this is exact for points
+ * away from the surface and much faster than a Boolean.
+ *
+ * @param points The query points.
+ */
+std::vector<Containment> Manifold::Contains(VecView<const vec3> points) const {
+  const auto impl = GetCsgLeafNode().GetImpl();
+  const double tolerance = impl->tolerance_;
+  std::vector<Containment> result(points.size());
+  for_each_n(autoPolicy(points.size(), 1e3), countAt(0_uz), points.size(),
+             [&](size_t i) {
+               if (tolerance > 0 &&
+                   impl->Distance(points[i], tolerance) < tolerance) {
+                 result[i] = Containment::Surface;
+               } else {
+                 result[i] = impl->WindingNumber(points[i]) != 0
+                                 ? Containment::Inside
+                                 : Containment::Outside;
+               }
+             });
+  return result;
+}
+
+/**
+ * Finds the nearest point on the surface to each of a batch of points in
+ * parallel, along with the normal and origin of the triangle it lies on.
+ *
+ * @param points The query points.
+ * @param maxDistance Only surface within this distance of a point is found;
+ * smaller values allow faster queries.
+ */
+std::vector<SurfacePoint> Manifold::ClosestPoints(VecView<const vec3> points,
+                                                  double maxDistance) const {
+  const auto impl = GetCsgLeafNode().GetImpl();
+  std::vector<SurfacePoint> result(points.size());
+  for_each_n(autoPolicy(points.size(), 1e3), countAt(0_uz), points.size(),
+             [&](size_t i) {
+               result[i] = impl->ClosestPoint(points[i], maxDistance);
+             });
+  return result;
+}
 }  // namespace manifold
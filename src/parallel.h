@@ -18,7 +18,9 @@
 #pragma once
 
 #include "./iters.h"
-#if (MANIFOLD_PAR == 1)
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+#include "./thread_pool.h"
+#elif (MANIFOLD_PAR == 1)
 #include <tbb/combinable.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
@@ -30,6 +32,14 @@
 
 namespace manifold {
 
+// The parallel algorithms below are written against the TBB interface; the
+// native backend implements the subset of it that they use.
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+namespace par = ::manifold::pool;
+#elif (MANIFOLD_PAR == 1)
+namespace par = ::tbb;
+#endif
+
 enum class ExecutionPolicy {
   Par,
   Seq,
@@ -89,7 +99,7 @@ void mergeRec(SrcIter src, DestIter dest, size_t p1, size_t r1, size_t p2,
         std::distance(src, std::lower_bound(src + p2, src + r2, src[q1], comp));
     size_t q3 = p3 + (q1 - p1) + (q2 - p2);
     dest[q3] = src[q1];
-    tbb::parallel_invoke(
+    par::parallel_invoke(
         [=] { mergeRec(src, dest, p1, q1, p2, q2, p3, comp); },
         [=] { mergeRec(src, dest, q1 + 1, r1, q2, r2, q3 + 1, comp); });
   }
@@ -104,7 +114,7 @@ void mergeSortRec(SrcIter src, DestIter dest, size_t begin, size_t end,
     std::stable_sort(dest + begin, dest + end, comp);
   } else {
     size_t middle = begin + numElements / 2;
-    tbb::parallel_invoke([=] { mergeSortRec(dest, src, begin, middle, comp); },
+    par::parallel_invoke([=] { mergeSortRec(dest, src, begin, middle, comp); },
                          [=] { mergeSortRec(dest, src, middle, end, comp); });
     mergeRec(src, dest, begin, middle, middle, end, begin, comp);
   }
@@ -120,14 +130,14 @@ struct ScanBody {
 
   ScanBody(T sum, T identity, BinOp &f, InputIter input, OutputIter output)
       : sum(sum), identity(identity), f(f), input(input), output(output) {}
-  ScanBody(ScanBody &b, tbb::split)
+  ScanBody(ScanBody &b, par::split)
       : sum(b.identity),
         identity(b.identity),
         f(b.f),
         input(b.input),
         output(b.output) {}
   template <typename Tag>
-  void operator()(const tbb::blocked_range<size_t> &r, Tag) {
+  void operator()(const par::blocked_range<size_t> &r, Tag) {
     T temp = sum;
     for (size_t i = r.begin(); i < r.end(); ++i) {
       T inputTmp = input[i];
@@ -150,10 +160,10 @@ struct CopyIfScanBody {
 
   CopyIfScanBody(P &pred, InputIter input, OutputIter output)
       : sum(0), pred(pred), input(input), output(output) {}
-  CopyIfScanBody(CopyIfScanBody &b, tbb::split)
+  CopyIfScanBody(CopyIfScanBody &b, par::split)
       : sum(0), pred(b.pred), input(b.input), output(b.output) {}
   template <typename Tag>
-  void operator()(const tbb::blocked_range<size_t> &r, Tag) {
+  void operator()(const par::blocked_range<size_t> &r, Tag) {
     size_t temp = sum;
     for (size_t i = r.begin(); i < r.end(); ++i) {
       if (pred(i)) {
@@ -200,9 +210,9 @@ void histogram(T *ptr, typename H::SizeType n, H &hist) {
   if (n < kSeqThreshold) {
     worker(ptr, n, hist);
   } else {
-    tbb::combinable<H> store;
-    tbb::parallel_for(
-        tbb::blocked_range<typename H::SizeType>(0, n, kSeqThreshold),
+    par::combinable<H> store;
+    par::parallel_for(
+        par::blocked_range<typename H::SizeType>(0, n, kSeqThreshold),
         [&worker, &store, ptr](const auto &r) {
           worker(ptr + r.begin(), r.end() - r.begin(), store.local());
         });
@@ -242,7 +252,7 @@ struct SortedRange {
 
   SortedRange(T *input, T *tmp, SizeType offset = 0, SizeType length = 0)
       : input(input), tmp(tmp), offset(offset), length(length) {}
-  SortedRange(SortedRange<T, SizeType> &r, tbb::split)
+  SortedRange(SortedRange<T, SizeType> &r, par::split)
       : input(r.input), tmp(r.tmp) {}
   // FIXME: no idea why thread sanitizer reports data race here
 #if defined(__has_feature)
@@ -251,7 +261,7 @@ struct SortedRange {
 #endif
 #endif
   void
-  operator()(const tbb::blocked_range<SizeType> &range) {
+  operator()(const par::blocked_range<SizeType> &range) {
     SortedRange<T, SizeType> rhs(input, tmp, range.begin(),
                                  range.end() - range.begin());
     rhs.inTmp =
@@ -288,10 +298,10 @@ struct SortedRange {
 template <typename T, typename SizeTy>
 void radix_sort(T *input, SizeTy n) {
   T *aux = new T[n];
-  SizeTy blockSize = std::max(n / tbb::this_task_arena::max_concurrency() / 4,
+  SizeTy blockSize = std::max(n / par::this_task_arena::max_concurrency() / 4,
                               static_cast<SizeTy>(kSeqThreshold / sizeof(T)));
   SortedRange<T, SizeTy> result(input, aux);
-  tbb::parallel_reduce(tbb::blocked_range<SizeTy>(0, n, blockSize), result);
+  par::parallel_reduce(par::blocked_range<SizeTy>(0, n, blockSize), result);
   if (result.inTmp) copy(aux, aux + n, input);
   delete[] aux;
 }
@@ -304,7 +314,7 @@ void mergeSort(ExecutionPolicy policy, Iterator first, Iterator last,
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
     // apparently this prioritizes threads inside here?
-    tbb::this_task_arena::isolate([&] {
+    par::this_task_arena::isolate([&] {
       size_t length = std::distance(first, last);
       T *tmp = new T[length];
       copy(policy, first, last, tmp);
@@ -378,8 +388,8 @@ void for_each(ExecutionPolicy policy, Iter first, Iter last, F f) {
                 "You can only parallelize RandomAccessIterator.");
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
-    tbb::parallel_for(tbb::blocked_range<Iter>(first, last),
-                      [&f](const tbb::blocked_range<Iter> &range) {
+    par::parallel_for(par::blocked_range<Iter>(first, last),
+                      [&f](const par::blocked_range<Iter> &range) {
                         for (Iter i = range.begin(); i != range.end(); i++)
                           f(*i);
                       });
@@ -415,10 +425,10 @@ T reduce(ExecutionPolicy policy, InputIter first, InputIter last, T init,
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
     // should we use deterministic reduce here?
-    return tbb::parallel_reduce(
-        tbb::blocked_range<InputIter>(first, last, details::kSeqThreshold),
+    return par::parallel_reduce(
+        par::blocked_range<InputIter>(first, last, details::kSeqThreshold),
         init,
-        [&f](const tbb::blocked_range<InputIter> &range, T value) {
+        [&f](const par::blocked_range<InputIter> &range, T value) {
           return std::reduce(range.begin(), range.end(), value, f);
         },
         f);
@@ -490,10 +500,10 @@ void inclusive_scan(ExecutionPolicy policy, InputIter first, InputIter last,
       "You can only parallelize RandomAccessIterator.");
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
-    tbb::parallel_scan(
-        tbb::blocked_range<size_t>(0, std::distance(first, last)),
+    par::parallel_scan(
+        par::blocked_range<size_t>(0, std::distance(first, last)),
         static_cast<T>(0),
-        [&](const tbb::blocked_range<size_t> &range, T sum,
+        [&](const par::blocked_range<size_t> &range, T sum,
             bool is_final_scan) {
           T temp = sum;
           for (size_t i = range.begin(); i < range.end(); ++i) {
@@ -554,8 +564,8 @@ void exclusive_scan(ExecutionPolicy policy, InputIter first, InputIter last,
   if (policy == ExecutionPolicy::Par) {
     details::ScanBody<T, InputIter, OutputIter, BinOp> body(init, identity, f,
                                                             first, d_first);
-    tbb::parallel_scan(
-        tbb::blocked_range<size_t>(0, std::distance(first, last)), body);
+    par::parallel_scan(
+        par::blocked_range<size_t>(0, std::distance(first, last)), body);
     return;
   }
 #endif
@@ -605,9 +615,9 @@ void transform(ExecutionPolicy policy, InputIter first, InputIter last,
       "You can only parallelize RandomAccessIterator.");
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
-    tbb::parallel_for(tbb::blocked_range<size_t>(
+    par::parallel_for(par::blocked_range<size_t>(
                           0, static_cast<size_t>(std::distance(first, last))),
-                      [&](const tbb::blocked_range<size_t> &range) {
+                      [&](const par::blocked_range<size_t> &range) {
                         std::transform(first + range.begin(),
                                        first + range.end(),
                                        d_first + range.begin(), f);
@@ -649,10 +659,10 @@ void copy(ExecutionPolicy policy, InputIter first, InputIter last,
       "You can only parallelize RandomAccessIterator.");
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
-    tbb::parallel_for(tbb::blocked_range<size_t>(
+    par::parallel_for(par::blocked_range<size_t>(
                           0, static_cast<size_t>(std::distance(first, last)),
                           details::kSeqThreshold),
-                      [&](const tbb::blocked_range<size_t> &range) {
+                      [&](const par::blocked_range<size_t> &range) {
                         std::copy(first + range.begin(), first + range.end(),
                                   d_first + range.begin());
                       });
@@ -706,8 +716,8 @@ void fill(ExecutionPolicy policy, OutputIter first, OutputIter last, T value) {
       "You can only parallelize RandomAccessIterator.");
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
-    tbb::parallel_for(tbb::blocked_range<OutputIter>(first, last),
-                      [&](const tbb::blocked_range<OutputIter> &range) {
+    par::parallel_for(par::blocked_range<OutputIter>(first, last),
+                      [&](const par::blocked_range<OutputIter> &range) {
                         std::fill(range.begin(), range.end(), value);
                       });
     return;
@@ -754,9 +764,9 @@ bool all_of(ExecutionPolicy policy, InputIter first, InputIter last, P pred) {
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par) {
     // should we use deterministic reduce here?
-    return tbb::parallel_reduce(
-        tbb::blocked_range<InputIter>(first, last), true,
-        [&](const tbb::blocked_range<InputIter> &range, bool value) {
+    return par::parallel_reduce(
+        par::blocked_range<InputIter>(first, last), true,
+        [&](const par::blocked_range<InputIter> &range, bool value) {
           if (!value) return false;
           for (InputIter i = range.begin(); i != range.end(); i++)
             if (!pred(*i)) return false;
@@ -802,8 +812,8 @@ OutputIter copy_if(ExecutionPolicy policy, InputIter first, InputIter last,
   if (policy == ExecutionPolicy::Par) {
     auto pred2 = [&](size_t i) { return pred(first[i]); };
     details::CopyIfScanBody body(pred2, first, d_first);
-    tbb::parallel_scan(
-        tbb::blocked_range<size_t>(0, std::distance(first, last)), body);
+    par::parallel_scan(
+        par::blocked_range<size_t>(0, std::distance(first, last)), body);
     return d_first + body.get_sum();
   }
 #endif
@@ -941,6 +951,7 @@ Iter unique(ExecutionPolicy policy, Iter first, Iter last) {
                 "not trivially destructable.");
 #if (MANIFOLD_PAR == 1)
   if (policy == ExecutionPolicy::Par && first != last) {
+    const Iter begin = first;
     Iter newSrcStart = first;
     // cap the maximum buffer size, proved to be beneficial for unique with huge
     // array size
@@ -953,11 +964,14 @@ Iter unique(ExecutionPolicy policy, Iter first, Iter last) {
           std::min(MAX_BUFFER_SIZE,
                    static_cast<size_t>(std::distance(newSrcStart, last)));
       copy(policy, newSrcStart, newSrcStart + length, tmp);
-      *first = *newSrcStart;
+      // a group may straddle the buffer boundary, in which case the first
+      // element of this chunk replaces the equal one already kept.
+      if (first != begin && *(first - 1) == tmp[0]) --first;
+      *first = tmp[0];
       // this is not a typo, the index i is offset by 1, so to compare an
       // element with its predecessor we need to compare i and i + 1.
       details::CopyIfScanBody body(pred, tmp + 1, first + 1);
-      tbb::parallel_scan(tbb::blocked_range<size_t>(0, length - 1), body);
+      par::parallel_scan(par::blocked_range<size_t>(0, length - 1), body);
       first += body.get_sum() + 1;
       newSrcStart += length;
     } while (newSrcStart != last);
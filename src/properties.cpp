@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 
 #include "./impl.h"
@@ -21,6 +23,38 @@
 namespace {
 using namespace manifold;
 
+// Whether p is left of the XY line a->b. Ties are broken by symbolically
+// perturbing p by (e, e^2), so a point on an edge shared by two triangles
+// lands in exactly one of them and ray parity counts each crossing once.
+inline bool LeftOf(vec2 a, vec2 b, vec2 p) {
+  const double det = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+  if (det != 0) return det > 0;
+  if (a.y != b.y) return a.y > b.y;
+  return b.x > a.x;
+}
+
+// Signed crossing of the +z ray from p with the triangle: +1 where the ray
+// exits through a triangle facing up, -1 where it enters, 0 if it misses.
+inline int RayCrossing(const std::array<vec3, 3>& tri, vec3 p) {
+  const vec2 a(tri[0].x, tri[0].y);
+  const vec2 b(tri[1].x, tri[1].y);
+  const vec2 c(tri[2].x, tri[2].y);
+  const vec2 q(p.x, p.y);
+  const bool ab = LeftOf(a, b, q);
+  if (LeftOf(b, c, q) != ab || LeftOf(c, a, q) != ab) return 0;
+
+  const double area = la::cross(b - a, c - a);
+  if (area == 0) return 0;
+  const double wa = la::cross(b - q, c - q) / area;
+  const double wb = la::cross(c - q, a - q) / area;
+  const double wc = 1 - wa - wb;
+  const double z = la::clamp(wa * tri[0].z + wb * tri[1].z + wc * tri[2].z,
+                             std::min({tri[0].z, tri[1].z, tri[2].z}),
+                             std::max({tri[0].z, tri[1].z, tri[2].z}));
+  if (z <= p.z) return 0;
+  return ab ? 1 : -1;
+}
+
 struct CurvatureAngles {
   VecView<double> meanCurvature;
   VecView<double> gaussianCurvature;
@@ -167,6 +201,77 @@ struct CheckCCW {
     return check;
   }
 };
+
+// A ray sheared to point along +z for the watertight ray-triangle test of
+// Woop, Benthin and Wald, "Watertight Ray/Triangle Intersection", JCGT 2013.
+// The edge functions of a shared edge are computed from the same two sheared
+// verts with opposite signs, so a ray can't slip between adjacent triangles.
+struct ShearedRay {
+  vec3 origin;
+  vec3 direction;
+  int kx, ky, kz;
+  vec3 shear;
+
+  ShearedRay(vec3 origin, vec3 direction)
+      : origin(origin), direction(direction) {
+    const vec3 absDir = la::abs(direction);
+    kz = absDir.x > absDir.y ? (absDir.x > absDir.z ? 0 : 2)
+                             : (absDir.y > absDir.z ? 1 : 2);
+    kx = (kz + 1) % 3;
+    ky = (kx + 1) % 3;
+    // Keep the winding of the sheared triangles.
+    if (direction[kz] < 0) std::swap(kx, ky);
+    shear = vec3(direction[kx] / direction[kz], direction[ky] / direction[kz],
+                 1 / direction[kz]);
+  }
+
+  // The distance at which the ray enters the box, or infinity if it misses.
+  double BoxEntry(const Box& box) const {
+    // Pads the exit against rounding so triangles lying in a face of their
+    // box aren't missed.
+    constexpr double kPad = 1 + 4 * std::numeric_limits<double>::epsilon();
+    double tMin = 0;
+    double tMax = std::numeric_limits<double>::infinity();
+    for (const int i : {0, 1, 2}) {
+      if (direction[i] == 0) {
+        if (origin[i] < box.min[i] || origin[i] > box.max[i])
+          return std::numeric_limits<double>::infinity();
+        continue;
+      }
+      double t0 = (box.min[i] - origin[i]) / direction[i];
+      double t1 = (box.max[i] - origin[i]) / direction[i];
+      if (t0 > t1) std::swap(t0, t1);
+      tMin = std::max(tMin, t0);
+      tMax = std::min(tMax, t1 * kPad);
+    }
+    return tMin <= tMax ? tMin : std::numeric_limits<double>::infinity();
+  }
+
+  // The distance to a hit beyond the origin, or infinity if it misses, in
+  // which case barycentric is not set.
+  double Hit(const std::array<vec3, 3>& tri, vec3& barycentric) const {
+    const vec3 a = tri[0] - origin;
+    const vec3 b = tri[1] - origin;
+    const vec3 c = tri[2] - origin;
+    const double ax = a[kx] - shear.x * a[kz];
+    const double ay = a[ky] - shear.y * a[kz];
+    const double bx = b[kx] - shear.x * b[kz];
+    const double by = b[ky] - shear.y * b[kz];
+    const double cx = c[kx] - shear.x * c[kz];
+    const double cy = c[ky] - shear.y * c[kz];
+    const double u = cx * by - cy * bx;
+    const double v = ax * cy - ay * cx;
+    const double w = bx * ay - by * ax;
+    if ((u < 0 || v < 0 || w < 0) && (u > 0 || v > 0 || w > 0))
+      return std::numeric_limits<double>::infinity();
+    const double det = u + v + w;
+    if (det == 0) return std::numeric_limits<double>::infinity();
+    const double t = (u * a[kz] + v * b[kz] + w * c[kz]) * shear.z / det;
+    if (!(t > 0)) return std::numeric_limits<double>::infinity();
+    barycentric = vec3(u, v, w) / det;
+    return t;
+  }
+};
 }  // namespace
 
 namespace manifold {
@@ -445,4 +550,210 @@ double Manifold::Impl::MinGap(const Manifold::Impl& other,
   return sqrt(minDistanceSquared);
 };
 
+/**
+ * Returns true if this and other, moved by transform, share any point,
+ * including touching surfaces. This traverses both colliders together and
+ * stops at the first pair of triangles found in contact, and otherwise checks
+ * whether either contains the other.
+ */
+bool Manifold::Impl::Overlaps(const Impl& other,
+                              const mat3x4& transform) const {
+  ZoneScoped;
+  if (IsEmpty() || other.IsEmpty()) return false;
+
+  std::atomic<bool> overlaps(false);
+  collider_.ForEachCollision(
+      other.collider_, transform, [&](int tri, int triOther) {
+        std::array<vec3, 3> p;
+        std::array<vec3, 3> q;
+        for (const int j : {0, 1, 2}) {
+          p[j] = vertPos_[halfedge_[3 * tri + j].startVert];
+          const int vert = other.halfedge_[3 * triOther + j].startVert;
+          q[j] = transform * vec4(other.vertPos_[vert], 1.0);
+        }
+        if (DistanceTriangleTriangleSquared(p, q) > 0) return true;
+        overlaps = true;
+        return false;
+      });
+  if (overlaps) return true;
+  // The surfaces don't touch, so either one contains the other or they're
+  // disjoint.
+  if (WindingNumber(transform * vec4(other.vertPos_[0], 1.0)) != 0) return true;
+  // A singular transform flattens other, which then contains nothing, and
+  // would not be invertible.
+  const mat3 linear(transform[0], transform[1], transform[2]);
+  if (la::determinant(linear) == 0) return false;
+  const mat3 inverse = la::inverse(linear);
+  return other.WindingNumber(inverse * (vertPos_[0] - transform[3])) != 0;
+}
+
+/**
+ * Returns the number of edge-face bounding box overlaps between this and other
+ * moved by transform, in both directions, as EdgeCollisions would find against
+ * a transformed copy of other. Each edge lies within its triangle's box, so
+ * every overlap is found among the triangle pairs of a joint traversal of both
+ * colliders. Edges are tested only from their forward halfedge, so each is
+ * counted once.
+ */
+size_t Manifold::Impl::NumEdgeOverlaps(const Impl& other,
+                                       const mat3x4& transform) const {
+  ZoneScoped;
+  std::atomic<size_t> numOverlap(0);
+  collider_.ForEachCollision(
+      other.collider_, transform, [&](int tri, int triOther) {
+        std::array<vec3, 3> p;
+        std::array<vec3, 3> q;
+        Box boxP;
+        Box boxQ;
+        for (const int j : {0, 1, 2}) {
+          p[j] = vertPos_[halfedge_[3 * tri + j].startVert];
+          const int vert = other.halfedge_[3 * triOther + j].startVert;
+          q[j] = transform * vec4(other.vertPos_[vert], 1.0);
+          boxP.Union(p[j]);
+          boxQ.Union(q[j]);
+        }
+        size_t count = 0;
+        for (const int j : {0, 1, 2}) {
+          if (halfedge_[3 * tri + j].IsForward())
+            count += boxQ.DoesOverlap(Box(p[j], p[Next3(j)]));
+          if (other.halfedge_[3 * triOther + j].IsForward())
+            count += boxP.DoesOverlap(Box(q[j], q[Next3(j)]));
+        }
+        if (count > 0) numOverlap += count;
+        return true;
+      });
+  return numOverlap;
+}
+
+/**
+ * Returns the minimum distance between this and other moved by transform, up
+ * to searchLength, by traversing both colliders together. Unlike the version
+ * above, this touches only the triangles near the gap.
+ */
+double Manifold::Impl::MinGap(const Impl& other, double searchLength,
+                              const mat3x4& transform) const {
+  ZoneScoped;
+  double dist2 = searchLength * searchLength;
+  collider_.NearestPair(
+      other.collider_, transform,
+      [&](int tri, int triOther) {
+        std::array<vec3, 3> p;
+        std::array<vec3, 3> q;
+        for (const int j : {0, 1, 2}) {
+          p[j] = vertPos_[halfedge_[3 * tri + j].startVert];
+          const int vert = other.halfedge_[3 * triOther + j].startVert;
+          q[j] = transform * vec4(other.vertPos_[vert], 1.0);
+        }
+        return DistanceTriangleTriangleSquared(p, q);
+      },
+      dist2);
+  return std::sqrt(dist2);
+}
+
+/**
+ * Returns the winding number of the surface around the given point, by the
+ * parity of crossings along a ray in +z, as in Boolean3's shadows.
+ */
+int Manifold::Impl::WindingNumber(vec3 point) const {
+  if (!bBox_.DoesOverlap(point) || point.z > bBox_.max.z) return 0;
+  const Box ray(point, vec3(point.x, point.y, bBox_.max.z));
+  int winding = 0;
+  collider_.ForEachCollision(ray, [&](int tri) {
+    std::array<vec3, 3> p;
+    for (const int j : {0, 1, 2})
+      p[j] = vertPos_[halfedge_[3 * tri + j].startVert];
+    winding += RayCrossing(p, point);
+  });
+  return winding;
+}
+
+/**
+ * Returns the triangle nearest to the point, or -1 if none is nearer than the
+ * square root of dist2, which is updated to the nearest squared distance.
+ */
+int Manifold::Impl::NearestTri(vec3 point, double& dist2) const {
+  return collider_.Nearest(
+      // Boxes that contain the point are all at distance zero, so they are
+      // ordered by the distance to their centers instead.
+      [point](const Box& box) {
+        const vec3 d = la::max(la::max(box.min - point, point - box.max), 0.0);
+        const vec3 c = box.Center() - point;
+        return vec2(la::dot(d, d), la::dot(c, c));
+      },
+      [&](int tri) {
+        std::array<vec3, 3> p;
+        for (const int j : {0, 1, 2})
+          p[j] = vertPos_[halfedge_[3 * tri + j].startVert];
+        const vec3 d = ClosestPointOnTriangle(point, p) - point;
+        return la::dot(d, d);
+      },
+      dist2);
+}
+
+/**
+ * Returns the distance from the point to the nearest triangle, saturating at
+ * maxDistance.
+ */
+double Manifold::Impl::Distance(vec3 point, double maxDistance) const {
+  double dist2 = maxDistance * maxDistance;
+  NearestTri(point, dist2);
+  return std::min(std::sqrt(dist2), maxDistance);
+}
+
+/**
+ * Returns the nearest point on the surface within maxDistance of the given
+ * point, if any.
+ */
+SurfacePoint Manifold::Impl::ClosestPoint(vec3 point,
+                                          double maxDistance) const {
+  SurfacePoint result;
+  double dist2 = maxDistance * maxDistance;
+  const int tri = NearestTri(point, dist2);
+  if (tri < 0) return result;
+  std::array<vec3, 3> p;
+  for (const int j : {0, 1, 2})
+    p[j] = vertPos_[halfedge_[3 * tri + j].startVert];
+  result.position = ClosestPointOnTriangle(point, p);
+  result.distance = la::distance(result.position, point);
+  result.normal = faceNormal_[tri];
+  result.originalID = meshRelation_.triRef[tri].originalID;
+  result.faceID = meshRelation_.triRef[tri].tri;
+  return result;
+}
+
+/**
+ * Returns the distance from the point to the nearest triangle, positive inside
+ * and negative outside, saturating at +/-maxDistance.
+ */
+double Manifold::Impl::SignedDistance(vec3 point, double maxDistance) const {
+  const double dist = Distance(point, maxDistance);
+  return WindingNumber(point) != 0 ? dist : -dist;
+}
+
+/**
+ * Returns the first hit of the ray along its direction, excluding its origin.
+ */
+RayHit Manifold::Impl::RayCast(vec3 origin, vec3 direction) const {
+  RayHit hit;
+  if (direction == vec3(0.0)) return hit;
+  const ShearedRay ray(origin, direction);
+  const int tri = collider_.Nearest(
+      [&ray](const Box& box) { return vec2(ray.BoxEntry(box), 0.0); },
+      [&](int tri) {
+        std::array<vec3, 3> p;
+        for (const int j : {0, 1, 2})
+          p[j] = vertPos_[halfedge_[3 * tri + j].startVert];
+        vec3 barycentric;
+        const double t = ray.Hit(p, barycentric);
+        // This hit becomes the nearest exactly when it beats hit.distance.
+        if (t < hit.distance) hit.barycentric = barycentric;
+        return t;
+      },
+      hit.distance);
+  if (tri < 0) return hit;
+  hit.normal = faceNormal_[tri];
+  hit.originalID = meshRelation_.triRef[tri].originalID;
+  hit.faceID = meshRelation_.triRef[tri].tri;
+  return hit;
+}
 }  // namespace manifold
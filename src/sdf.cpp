@@ -12,12 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+
+#include "./csg_tree.h"
 #include "./hashtable.h"
 #include "./impl.h"
 #include "./parallel.h"
 #include "./utils.h"
 #include "./vec.h"
 #include "manifold/manifold.h"
+#include "manifold/sdf.h"
 
 namespace {
 using namespace manifold;
@@ -31,6 +35,14 @@ constexpr double kS = 0.25;
 constexpr double kD = 1 / kS - 1;
 // Maximum number of opposed verts (of 7) to allow collapse.
 constexpr int kMaxOpposed = 3;
+// Grid points per side of a block, which is the unit of sparse evaluation.
+constexpr int kBlockSize = 8;
+// Grid points per block, counting both of the interleaved cubic grids.
+constexpr int kBlockVerts = 2 * kBlockSize * kBlockSize * kBlockSize;
+
+using BatchSDF = std::function<void(VecView<const vec3>, VecView<double>)>;
+// Bounds the sdf over each box by an interval {min, max}.
+using BatchBound = std::function<void(VecView<const Box>, VecView<vec2>)>;
 
 ivec3 TetTri0(int i) {
   constexpr ivec3 tetTri0[16] = {{-1, -1, -1},  //
@@ -121,44 +133,135 @@ vec3 Bound(vec3 pos, vec3 origin, vec3 spacing, ivec3 gridSize) {
   return min(max(pos, origin), origin + spacing * (vec3(gridSize) - 1));
 }
 
-double BoundedSDF(ivec4 gridIndex, vec3 origin, vec3 spacing, ivec3 gridSize,
-                  double level, std::function<double(vec3)> sdf) {
+// Distance in grid steps of this grid point inside the bounds, which is
+// negative for the padding outside them.
+int BoundDist(ivec4 gridIndex, ivec3 gridSize) {
   const ivec3 xyz(gridIndex);
   const int lowerBoundDist = minelem(xyz);
   const int upperBoundDist = minelem(gridSize - xyz);
-  const int boundDist = std::min(lowerBoundDist, upperBoundDist - gridIndex.w);
+  return std::min(lowerBoundDist, upperBoundDist - gridIndex.w);
+}
 
+// Applies the bounds to an SDF value, so that the surface is closed there.
+double BoundedSDF(int boundDist, double d) {
   if (boundDist < 0) {
     return 0.0;
   }
-  const double d = sdf(Position(gridIndex, origin, spacing)) - level;
   return boundDist == 0 ? std::min(d, 0.0) : d;
 }
 
-// Simplified ITP root finding algorithm - same worst-case performance as
-// bisection, better average performance.
-inline vec3 FindSurface(vec3 pos0, double d0, vec3 pos1, double d1, double tol,
-                        double level, std::function<double(vec3)> sdf) {
-  if (d0 == 0) {
-    return pos0;
-  } else if (d1 == 0) {
-    return pos1;
+// Calls func on batches of at most kBlockVerts inputs, which writes one output
+// per input.
+template <typename In, typename Out, typename Func>
+void EvalBatched(ExecutionPolicy policy, const Func& func, VecView<const In> in,
+                 VecView<Out> out) {
+  const size_t numBatch = (in.size() + kBlockVerts - 1) / kBlockVerts;
+  for_each_n(policy, countAt(0_uz), numBatch, [&](size_t batch) {
+    const size_t start = batch * kBlockVerts;
+    const size_t size = std::min<size_t>(kBlockVerts, in.size() - start);
+    func(in.view(start, size), out.view(start, size));
+  });
+}
+
+Uint64 EncodeBlock(ivec3 block, ivec3 numBlocks) {
+  return (static_cast<Uint64>(block.x) * numBlocks.y + block.y) * numBlocks.z +
+         block.z;
+}
+
+ivec3 DecodeBlock(Uint64 idx, ivec3 numBlocks) {
+  ivec3 block;
+  block.z = idx % numBlocks.z;
+  idx /= numBlocks.z;
+  block.y = idx % numBlocks.y;
+  block.x = idx / numBlocks.y;
+  return block;
+}
+
+/**
+ * The SDF values of the grid, stored in blocks of kBlockSize^3 grid points of
+ * each cubic grid. Only the blocks in the band near the surface are evaluated
+ * and stored; a block outside the band is represented by a single value whose
+ * sign is shared by all of its grid points and their neighbors, which is all
+ * that is needed of grid points with no crossing edges. Blocks are indexed
+ * relative to blockOffset, so that a tile stores only its own region.
+ */
+struct Voxels {
+  VecView<const double> bandValue;
+  VecView<const Uint64> bandBlock;
+  VecView<const int64_t> blockSlot;
+  VecView<const double> blockValue;
+  const ivec3 blockOffset;
+  const ivec3 numBlocks;
+
+  // Grid index of the ith grid point of the band.
+  inline ivec4 GridIndex(Uint64 i) const {
+    const ivec3 block =
+        DecodeBlock(bandBlock[i / kBlockVerts], numBlocks) + blockOffset;
+    int local = i % kBlockVerts;
+    ivec4 voxel;
+    voxel.w = local & 1;
+    local >>= 1;
+    voxel.z = local % kBlockSize;
+    local /= kBlockSize;
+    voxel.y = local % kBlockSize;
+    voxel.x = local / kBlockSize;
+    return voxel + ivec4(block * kBlockSize, 0) - kVoxelOffset;
   }
 
-  // Sole tuning parameter, k: (0, 1) - smaller value gets better median
-  // performance, but also hits the worst case more often.
-  const double k = 0.1;
-  const double check = 2 * tol / la::length(pos0 - pos1);
+  inline double operator()(ivec4 gridIndex) const {
+    const ivec4 voxel = gridIndex + kVoxelOffset;
+    const ivec3 block = ivec3(voxel) / kBlockSize;
+    const Uint64 blockIndex = EncodeBlock(block - blockOffset, numBlocks);
+    const int64_t slot = blockSlot[blockIndex];
+    if (slot < 0) return blockValue[blockIndex];
+    const ivec3 local = ivec3(voxel) - block * kBlockSize;
+    return bandValue[slot * kBlockVerts +
+                     (((local.x * kBlockSize + local.y) * kBlockSize + local.z)
+                      << 1) +
+                     voxel.w];
+  }
+};
+
+/**
+ * Simplified ITP root finding algorithm - same worst-case performance as
+ * bisection, better average performance. Each search holds the state of one
+ * edge, so that all the edges can be refined together, with one batch of SDF
+ * evaluations per step.
+ */
+struct SurfaceSearch {
+  vec3 pos0;
+  vec3 pos1;
+  double d0;
+  double d1;
+  double check;
   double frac = 1;
   double biFrac = 1;
-  while (frac > check) {
+  double x = 0;
+
+  SurfaceSearch() = default;
+
+  SurfaceSearch(vec3 pos0, double d0, vec3 pos1, double d1, double tol)
+      : pos0(pos0),
+        pos1(pos1),
+        d0(d0),
+        d1(d1),
+        check(d0 == 0 || d1 == 0
+                  ? std::numeric_limits<double>::infinity()
+                  : 2 * tol / la::length(pos0 - pos1)) {}
+
+  bool Active() const { return frac > check; }
+
+  vec3 Next() {
+    // Sole tuning parameter, k: (0, 1) - smaller value gets better median
+    // performance, but also hits the worst case more often.
+    const double k = 0.1;
     const double t = la::lerp(d0 / (d0 - d1), 0.5, k);
     const double r = biFrac / frac - 0.5;
-    const double x = la::abs(t - 0.5) < r ? t : 0.5 - r * (t < 0.5 ? 1 : -1);
-
-    const vec3 mid = la::lerp(pos0, pos1, x);
-    const double d = sdf(mid) - level;
+    x = la::abs(t - 0.5) < r ? t : 0.5 - r * (t < 0.5 ? 1 : -1);
+    return la::lerp(pos0, pos1, x);
+  }
 
+  void Update(vec3 mid, double d) {
     if ((d > 0) == (d0 > 0)) {
       d0 = d;
       pos0 = mid;
@@ -171,7 +274,40 @@ inline vec3 FindSurface(vec3 pos0, double d0, vec3 pos1, double d1, double tol,
     biFrac /= 2;
   }
 
-  return la::lerp(pos0, pos1, d0 / (d0 - d1));
+  vec3 Surface() const {
+    if (d0 == 0) {
+      return pos0;
+    } else if (d1 == 0) {
+      return pos1;
+    }
+    return la::lerp(pos0, pos1, d0 / (d0 - d1));
+  }
+};
+
+void FindSurfaces(ExecutionPolicy policy, VecView<SurfaceSearch> searches,
+                  const BatchSDF& sdf, double level) {
+  ZoneScoped;
+  Vec<size_t> active(searches.size());
+  active.resize(copy_if(policy, countAt(0_uz), countAt(searches.size()),
+                        active.begin(),
+                        [&](size_t i) { return searches[i].Active(); }) -
+                active.begin());
+  Vec<vec3> mid;
+  Vec<double> d;
+  while (!active.empty()) {
+    const size_t size = active.size();
+    mid.resize(size);
+    d.resize(size);
+    for_each_n(policy, countAt(0_uz), size,
+               [&](size_t i) { mid[i] = searches[active[i]].Next(); });
+    EvalBatched<vec3, double>(policy, sdf, mid, d);
+    for_each_n(policy, countAt(0_uz), size, [&](size_t i) {
+      searches[active[i]].Update(mid[i], d[i] - level);
+    });
+    active.resize(remove_if(policy, active.begin(), active.end(),
+                            [&](size_t i) { return !searches[i].Active(); }) -
+                  active.begin());
+  }
 }
 
 /**
@@ -198,39 +334,47 @@ struct GridVert {
   }
 };
 
+/**
+ * A GridVert that may be moved onto the surface, once its search along the
+ * edge to its closest opposed neighbor is complete.
+ */
+struct Candidate {
+  Uint64 index;
+  GridVert gridVert;
+};
+
 struct NearSurface {
-  VecView<vec3> vertPos;
-  VecView<int> vertIndex;
+  VecView<Candidate> candidates;
+  VecView<SurfaceSearch> searches;
+  VecView<int> candidateIndex;
   HashTableD<GridVert> gridVerts;
-  VecView<const double> voxels;
-  const std::function<double(vec3)> sdf;
+  const Voxels voxels;
   const vec3 origin;
-  const ivec3 gridSize;
+  const ivec3 lower;
+  const ivec3 upper;
   const ivec3 gridPow;
   const vec3 spacing;
-  const double level;
   const double tol;
 
-  inline void operator()(Uint64 index) {
+  inline void operator()(Uint64 i) {
     ZoneScoped;
-    if (gridVerts.Full()) return;
+    const ivec4 gridIndex = voxels.GridIndex(i);
 
-    const ivec4 gridIndex = DecodeIndex(index, gridPow);
-
-    if (la::any(la::greater(ivec3(gridIndex), gridSize))) return;
+    if (la::any(la::less(ivec3(gridIndex), lower)) ||
+        la::any(la::greater(ivec3(gridIndex), upper)))
+      return;
+    const Uint64 index = EncodeIndex(gridIndex, gridPow);
 
     GridVert gridVert;
-    gridVert.distance = voxels[EncodeIndex(gridIndex + kVoxelOffset, gridPow)];
+    gridVert.distance = voxels(gridIndex);
 
     bool keep = false;
     double vMax = 0;
     int closestNeighbor = -1;
     int opposedVerts = 0;
     for (int i = 0; i < 7; ++i) {
-      const double val =
-          voxels[EncodeIndex(Neighbor(gridIndex, i) + kVoxelOffset, gridPow)];
-      const double valOp = voxels[EncodeIndex(
-          Neighbor(gridIndex, i + 7) + kVoxelOffset, gridPow)];
+      const double val = voxels(Neighbor(gridIndex, i));
+      const double valOp = voxels(Neighbor(gridIndex, i + 7));
 
       if (!gridVert.SameSide(val)) {
         gridVert.edgeVerts[i] = kCrossing;
@@ -258,41 +402,78 @@ struct NearSurface {
     // become an even-manifold with kissing verts. These must be removed in a
     // post-process: CleanupTopology().
     if (closestNeighbor >= 0 && opposedVerts <= kMaxOpposed) {
-      const vec3 gridPos = Position(gridIndex, origin, spacing);
+      const int idx = AtomicAdd(candidateIndex[0], 1);
       const ivec4 neighborIndex = Neighbor(gridIndex, closestNeighbor);
-      const vec3 pos = FindSurface(gridPos, gridVert.distance,
-                                   Position(neighborIndex, origin, spacing),
-                                   vMax, tol, level, sdf);
-      // Bound the delta of each vert to ensure the tetrahedron cannot invert.
-      if (la::all(la::less(la::abs(pos - gridPos), kS * spacing))) {
-        const int idx = AtomicAdd(vertIndex[0], 1);
-        vertPos[idx] = Bound(pos, origin, spacing, gridSize);
-        gridVert.movedVert = idx;
-        for (int j = 0; j < 7; ++j) {
-          if (gridVert.edgeVerts[j] == kCrossing) gridVert.edgeVerts[j] = idx;
-        }
-        keep = true;
-      }
-    } else {
-      for (int j = 0; j < 7; ++j) gridVert.edgeVerts[j] = kNone;
+      candidates[idx] = {index, gridVert};
+      searches[idx] = SurfaceSearch(Position(gridIndex, origin, spacing),
+                                    gridVert.distance,
+                                    Position(neighborIndex, origin, spacing),
+                                    vMax, tol);
+      return;
     }
 
+    for (int j = 0; j < 7; ++j) gridVert.edgeVerts[j] = kNone;
     if (keep) gridVerts.Insert(index, gridVert);
   }
 };
 
-struct ComputeVerts {
+struct MoveVerts {
   VecView<vec3> vertPos;
+  VecView<Uint64> vertKey;
   VecView<int> vertIndex;
   HashTableD<GridVert> gridVerts;
-  VecView<const double> voxels;
-  const std::function<double(vec3)> sdf;
+  VecView<const Candidate> candidates;
+  VecView<const SurfaceSearch> searches;
   const vec3 origin;
   const ivec3 gridSize;
   const ivec3 gridPow;
   const vec3 spacing;
-  const double level;
+
+  void operator()(int idx) {
+    GridVert gridVert = candidates[idx].gridVert;
+    bool keep = false;
+    for (int j = 0; j < 7; ++j) {
+      if (gridVert.edgeVerts[j] == kCrossing) keep = true;
+    }
+
+    const Uint64 index = candidates[idx].index;
+    const vec3 gridPos =
+        Position(DecodeIndex(index, gridPow), origin, spacing);
+    const vec3 pos = searches[idx].Surface();
+    // Bound the delta of each vert to ensure the tetrahedron cannot invert.
+    if (la::all(la::less(la::abs(pos - gridPos), kS * spacing))) {
+      const int vert = AtomicAdd(vertIndex[0], 1);
+      vertPos[vert] = Bound(pos, origin, spacing, gridSize);
+      if (!vertKey.empty()) vertKey[vert] = index << 3 | 7;
+      gridVert.movedVert = vert;
+      for (int j = 0; j < 7; ++j) {
+        if (gridVert.edgeVerts[j] == kCrossing) gridVert.edgeVerts[j] = vert;
+      }
+      keep = true;
+    }
+
+    if (keep) gridVerts.Insert(index, gridVert);
+  }
+};
+
+/**
+ * Each of the seven edges uniquely owned by a GridVert that crosses the surface
+ * creates a vert, unless the neighbor on it has moved. This is run twice: first
+ * to count the new verts of each GridVert, and then with those counts scanned
+ * into offsets to assign them and set up the searches for their positions.
+ */
+struct ComputeVerts {
+  VecView<int> vertOffset;
+  VecView<SurfaceSearch> searches;
+  VecView<Uint64> vertKey;
+  HashTableD<GridVert> gridVerts;
+  const Voxels voxels;
+  const vec3 origin;
+  const ivec3 gridPow;
+  const vec3 spacing;
   const double tol;
+  const int firstVert;
+  const bool count;
 
   void operator()(int idx) {
     ZoneScoped;
@@ -307,38 +488,43 @@ struct ComputeVerts {
 
     const vec3 position = Position(gridIndex, origin, spacing);
 
-    // These seven edges are uniquely owned by this gridVert; any of them
-    // which intersect the surface create a vert.
+    int newVert = count ? 0 : vertOffset[idx];
     for (int i = 0; i < 7; ++i) {
       const ivec4 neighborIndex = Neighbor(gridIndex, i);
       const GridVert& neighbor = gridVerts[EncodeIndex(neighborIndex, gridPow)];
 
-      const double val =
-          std::isfinite(neighbor.distance)
-              ? neighbor.distance
-              : voxels[EncodeIndex(neighborIndex + kVoxelOffset, gridPow)];
+      const double val = std::isfinite(neighbor.distance)
+                             ? neighbor.distance
+                             : voxels(neighborIndex);
       if (gridVert.SameSide(val)) continue;
 
       if (neighbor.HasMoved()) {
-        gridVert.edgeVerts[i] = neighbor.movedVert;
+        if (!count) gridVert.edgeVerts[i] = neighbor.movedVert;
         continue;
       }
 
-      const int idx = AtomicAdd(vertIndex[0], 1);
-      const vec3 pos = FindSurface(position, gridVert.distance,
-                                   Position(neighborIndex, origin, spacing),
-                                   val, tol, level, sdf);
-      vertPos[idx] = Bound(pos, origin, spacing, gridSize);
-      gridVert.edgeVerts[i] = idx;
+      if (!count) {
+        searches[newVert] =
+            SurfaceSearch(position, gridVert.distance,
+                          Position(neighborIndex, origin, spacing), val, tol);
+        gridVert.edgeVerts[i] = firstVert + newVert;
+        if (!vertKey.empty()) vertKey[firstVert + newVert] = baseKey << 3 | i;
+      }
+      ++newVert;
     }
+    if (count) vertOffset[idx + 1] = newVert;
   }
 };
 
+// Builds the triangles of the tetrahedra owned by each GridVert in
+// [ownLower, ownUpper), so that tiles sharing GridVerts never duplicate them.
 struct BuildTris {
   VecView<ivec3> triVerts;
   VecView<int> triIndex;
   const HashTableD<GridVert> gridVerts;
   const ivec3 gridPow;
+  const ivec3 ownLower;
+  const ivec3 ownUpper;
 
   void CreateTri(const ivec3& tri, const int edges[6]) {
     if (tri[0] < 0) return;
@@ -363,6 +549,9 @@ struct BuildTris {
 
     const GridVert& base = gridVerts.At(idx);
     const ivec4 baseIndex = DecodeIndex(baseKey, gridPow);
+    if (la::any(la::less(ivec3(baseIndex), ownLower)) ||
+        la::any(la::gequal(ivec3(baseIndex), ownUpper)))
+      return;
 
     ivec4 leadIndex = baseIndex;
     if (leadIndex.w == 0)
@@ -420,6 +609,398 @@ struct BuildTris {
     }
   }
 };
+
+// Catmull-Rom weights of the four samples around t in [0, 1). They sum to one,
+// and their absolute values to at most kCubicGain.
+vec4 CubicWeights(double t) {
+  const double t2 = t * t;
+  const double t3 = t2 * t;
+  return vec4(-t3 + 2 * t2 - t, 3 * t3 - 5 * t2 + 2, -3 * t3 + 4 * t2 + t,
+              t3 - t2) /
+         2.0;
+}
+constexpr double kCubicGain = 1.25 * 1.25 * 1.25;
+
+/**
+ * A volume of samples on a regular grid, stored densely with x varying
+ * fastest, and interpolated between them. It bounds a box by the range of the
+ * samples that can affect it, which is exact for trilinear interpolation; the
+ * tricubic overshoot is bounded by the sum of the absolute weights.
+ */
+struct SampledVolume {
+  VecView<const float> samples;
+  const ivec3 dims;
+  const vec3 origin;
+  const vec3 spacing;
+  const Interpolation interp;
+
+  inline double At(ivec3 i) const {
+    i = la::clamp(i, ivec3(0), dims - 1);
+    return samples[(static_cast<size_t>(i.z) * dims.y + i.y) * dims.x + i.x];
+  }
+
+  inline vec3 Coord(vec3 pos) const {
+    return la::clamp((pos - origin) / spacing, vec3(0.0), vec3(dims - 1));
+  }
+
+  double Trilinear(ivec3 i0, vec3 t) const {
+    double value = 0;
+    for (const int x : {0, 1}) {
+      for (const int y : {0, 1}) {
+        for (const int z : {0, 1}) {
+          const double w =
+              (x ? t.x : 1 - t.x) * (y ? t.y : 1 - t.y) * (z ? t.z : 1 - t.z);
+          value += w * At(i0 + ivec3(x, y, z));
+        }
+      }
+    }
+    return value;
+  }
+
+  double Tricubic(ivec3 i0, vec3 t) const {
+    const vec4 wx = CubicWeights(t.x);
+    const vec4 wy = CubicWeights(t.y);
+    const vec4 wz = CubicWeights(t.z);
+    double value = 0;
+    for (int z = 0; z < 4; ++z) {
+      for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+          value += wx[x] * wy[y] * wz[z] * At(i0 + ivec3(x - 1, y - 1, z - 1));
+        }
+      }
+    }
+    return value;
+  }
+
+  void operator()(VecView<const vec3> positions, VecView<double> values) const {
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const vec3 u = Coord(positions[i]);
+      const ivec3 i0 = la::min(ivec3(u), dims - 2);
+      const vec3 t = u - vec3(i0);
+      values[i] = interp == Interpolation::Tricubic ? Tricubic(i0, t)
+                                                    : Trilinear(i0, t);
+    }
+  }
+
+  void Bound(VecView<const Box> boxes, VecView<vec2> range) const {
+    const int pad = interp == Interpolation::Tricubic ? 1 : 0;
+    for (size_t b = 0; b < boxes.size(); ++b) {
+      const ivec3 lo = ivec3(la::floor(Coord(boxes[b].min))) - pad;
+      const ivec3 hi = ivec3(la::ceil(Coord(boxes[b].max))) + pad;
+      vec2 r(std::numeric_limits<double>::infinity(),
+             -std::numeric_limits<double>::infinity());
+      for (int z = lo.z; z <= hi.z; ++z) {
+        for (int y = lo.y; y <= hi.y; ++y) {
+          for (int x = lo.x; x <= hi.x; ++x) {
+            const double v = At({x, y, z});
+            r = {std::min(r.x, v), std::max(r.y, v)};
+          }
+        }
+      }
+      if (pad > 0) {
+        const double mid = (r.x + r.y) / 2;
+        const double half = kCubicGain * (r.y - r.x) / 2;
+        r = {mid - half, mid + half};
+      }
+      range[b] = r;
+    }
+  }
+};
+
+ivec3 GridSize(Box bounds, double edgeLength) {
+  return ivec3(bounds.Size() / edgeLength + 1.0);
+}
+
+struct TileMesh {
+  Vec<vec3> vertPos;
+  Vec<Uint64> vertKey;
+  Vec<ivec3> triVerts;
+};
+
+/**
+ * Meshes the GridVerts owned by the blocks in [ownMin, ownMax). The GridVerts
+ * within two grid steps beyond are processed as well, and the blocks within one
+ * block beyond are evaluated, so that the verts a tile shares with its
+ * neighbors are computed identically by each of them. If withKeys, each vert
+ * is labeled by its GridVert and edge, so that these can be merged.
+ */
+void MeshTile(TileMesh& mesh, const BatchSDF& sdf, const BatchBound& bound,
+              ExecutionPolicy pol, ivec3 ownMin, ivec3 ownMax, vec3 origin,
+              vec3 spacing, ivec3 gridSize, ivec3 gridPow, double level,
+              double tolerance, bool withKeys) {
+  ZoneScoped;
+  auto& vertPos = mesh.vertPos;
+  const ivec3 allBlocks((gridSize + 2) / kBlockSize + 1);
+  const ivec3 blockOffset = la::max(ownMin - 1, ivec3(0));
+  const ivec3 numBlocks = la::min(ownMax + 1, allBlocks) - blockOffset;
+  const Uint64 totalBlocks = static_cast<Uint64>(numBlocks.x) * numBlocks.y *
+                             numBlocks.z;
+  const Uint64 totalVerts = totalBlocks * kBlockVerts;
+
+  // A block is in the band unless its bound proves that it and its
+  // neighboring grid points are strictly on one side of the surface. Inside
+  // blocks near the bounds are always kept, since there BoundedSDF clamps the
+  // surface closed.
+  Vec<double> blockValue(bound ? totalBlocks : 0);
+  Vec<int64_t> blockSlot(totalBlocks, 1);
+  if (bound) {
+    Vec<Box> boxes(totalBlocks);
+    for_each_n(pol, countAt(0_uz), totalBlocks, [&](Uint64 b) {
+      const ivec3 lower =
+          (DecodeBlock(b, numBlocks) + blockOffset) * kBlockSize -
+          ivec3(kVoxelOffset) - 1;
+      const ivec3 upper = lower + kBlockSize + 1;
+      boxes[b] = {origin + spacing * (vec3(lower) - 0.5),
+                  origin + spacing * vec3(upper)};
+    });
+    Vec<vec2> range(totalBlocks);
+    EvalBatched<Box, vec2>(pol, bound, boxes, range);
+    for_each_n(pol, countAt(0_uz), totalBlocks, [&](Uint64 b) {
+      const ivec3 lower =
+          (DecodeBlock(b, numBlocks) + blockOffset) * kBlockSize -
+          ivec3(kVoxelOffset) - 1;
+      const ivec3 upper = lower + kBlockSize + 1;
+      const bool nearBounds = la::any(la::lequal(lower, ivec3(0))) ||
+                              la::any(la::gequal(upper, gridSize - 1));
+      const vec2 d = range[b] - level;
+      if (d.y < 0) {
+        blockValue[b] = d.y;
+        blockSlot[b] = 0;
+      } else if (d.x > 0 && !nearBounds) {
+        blockValue[b] = d.x;
+        blockSlot[b] = 0;
+      }
+    });
+  }
+  Vec<Uint64> bandBlock(totalBlocks);
+  bandBlock.resize(copy_if(pol, countAt(0_uz), countAt(totalBlocks),
+                           bandBlock.begin(),
+                           [&blockSlot](Uint64 b) { return blockSlot[b]; }) -
+                   bandBlock.begin());
+  const Uint64 numBand = bandBlock.size();
+  fill(pol, blockSlot.begin(), blockSlot.end(), -1);
+  for_each_n(pol, countAt(0_uz), numBand,
+             [&](Uint64 slot) { blockSlot[bandBlock[slot]] = slot; });
+
+  const Uint64 bandVerts = numBand * kBlockVerts;
+  Vec<double> bandValue(bandVerts);
+  const Voxels voxels = {bandValue,  bandBlock,  blockSlot,
+                         blockValue, blockOffset, numBlocks};
+  // Each block is one batch, skipping the padding outside the bounds.
+  for_each_n(pol, countAt(0_uz), numBand, [&](Uint64 slot) {
+    std::array<vec3, kBlockVerts> positions;
+    std::array<double, kBlockVerts> values;
+    std::array<int, kBlockVerts> local;
+    const Uint64 first = slot * kBlockVerts;
+    int size = 0;
+    for (int i = 0; i < kBlockVerts; ++i) {
+      const ivec4 gridIndex = voxels.GridIndex(first + i);
+      bandValue[first + i] = 0.0;
+      if (BoundDist(gridIndex, gridSize) < 0) continue;
+      positions[size] = Position(gridIndex, origin, spacing);
+      local[size++] = i;
+    }
+    sdf(VecView<const vec3>(positions.data(), size),
+        VecView<double>(values.data(), size));
+    for (int i = 0; i < size; ++i) {
+      const ivec4 gridIndex = voxels.GridIndex(first + local[i]);
+      bandValue[first + local[i]] =
+          BoundedSDF(BoundDist(gridIndex, gridSize), values[i] - level);
+    }
+  });
+
+  const ivec3 ownLower = ownMin * kBlockSize - ivec3(kVoxelOffset);
+  const ivec3 ownUpper = ownMax * kBlockSize - ivec3(kVoxelOffset);
+  const ivec3 lower = la::max(ownLower - 2, ivec3(0));
+  const ivec3 upper = la::min(ownUpper + 1, gridSize);
+
+  // The table starts from a guess at its size, and the band is processed in
+  // chunks small enough that it cannot fill, since each band vert inserts at
+  // most one GridVert. Between chunks the table grows, migrating its entries,
+  // so no work is ever repeated.
+  HashTable<GridVert> gridVerts(std::min(
+      2 * bandVerts, static_cast<Uint64>(10 * la::pow(totalVerts, 0.667))));
+  Vec<Candidate> candidates;
+  Vec<SurfaceSearch> searches;
+  Vec<int> vertIndex(1, 0);
+  Uint64 done = 0;
+  while (done < bandVerts) {
+    const Uint64 remaining = bandVerts - done;
+    if (gridVerts.Room() < std::min<Uint64>(remaining, gridVerts.Size() / 8)) {
+      // Grow by at least double, or to fit the rate of insertion so far.
+      const double rate =
+          done > 0 ? static_cast<double>(gridVerts.Entries()) / done : 1.0;
+      gridVerts.Reserve(std::min<Uint64>(
+          remaining, std::max(static_cast<double>(gridVerts.Size()),
+                              1.25 * rate * remaining)));
+    }
+    const Uint64 chunk = std::min<Uint64>(gridVerts.Room(), remaining);
+
+    candidates.resize(chunk);
+    searches.resize(chunk);
+    Vec<int> numCandidate(1, 0);
+    for_each_n(pol, countAt(done), chunk,
+               NearSurface({candidates, searches, numCandidate, gridVerts.D(),
+                            voxels, origin, lower, upper, gridPow, spacing,
+                            tolerance}));
+    searches.resize(numCandidate[0]);
+    FindSurfaces(pol, searches, sdf, level);
+
+    vertPos.resize(vertIndex[0] + numCandidate[0]);
+    if (withKeys) mesh.vertKey.resize(vertPos.size());
+    for_each_n(pol, countAt(0), numCandidate[0],
+               MoveVerts({vertPos, mesh.vertKey, vertIndex, gridVerts.D(),
+                          candidates, searches, origin, gridSize, gridPow,
+                          spacing}));
+    done += chunk;
+  }
+
+#ifdef MANIFOLD_DEBUG
+  if (ManifoldParams().verbose) {
+    const HashTableStats stats = gridVerts.Stats();
+    std::cout << "LevelSet GridVerts: " << stats.entries << " in "
+              << stats.capacity << " slots, load factor " << stats.loadFactor
+              << ", mean probe " << stats.meanProbe << ", max probe "
+              << stats.maxProbe << std::endl;
+  }
+#endif
+
+  const int numVert = vertIndex[0];
+  Vec<int> vertOffset(gridVerts.Size() + 1, 0);
+  for_each_n(pol, countAt(0), gridVerts.Size(),
+             ComputeVerts({vertOffset, {}, {}, gridVerts.D(), voxels, origin,
+                           gridPow, spacing, tolerance, numVert, true}));
+  inclusive_scan(vertOffset.begin(), vertOffset.end(), vertOffset.begin());
+  searches.resize(vertOffset.back());
+  if (withKeys) mesh.vertKey.resize(numVert + searches.size());
+  for_each_n(pol, countAt(0), gridVerts.Size(),
+             ComputeVerts({vertOffset, searches, mesh.vertKey, gridVerts.D(),
+                           voxels, origin, gridPow, spacing, tolerance, numVert,
+                           false}));
+  FindSurfaces(pol, searches, sdf, level);
+  vertPos.resize(numVert + searches.size());
+  for_each_n(pol, countAt(0_uz), searches.size(), [&](size_t i) {
+    vertPos[numVert + i] =
+        Bound(searches[i].Surface(), origin, spacing, gridSize);
+  });
+
+  auto& triVerts = mesh.triVerts;
+  triVerts.resize(gridVerts.Entries() * 12);  // worst case
+
+  Vec<int> index(1, 0);
+  for_each_n(pol, countAt(0), gridVerts.Size(),
+             BuildTris({triVerts, index, gridVerts.D(), gridPow, ownLower,
+                        ownUpper}));
+  triVerts.resize(index[0]);
+}
+
+/**
+ * The shared implementation of the LevelSet variants, on a grid of gridSize
+ * points spanning bounds. If bound is given, it is used to skip blocks of the
+ * grid far from the surface. If tileSize is
+ * positive, the grid is meshed in cubic tiles of about that many grid steps
+ * per side, one after another, and their verts are merged by key.
+ */
+std::shared_ptr<Manifold::Impl> LevelSetImpl(const BatchSDF& sdf,
+                                             const BatchBound& bound,
+                                             Box bounds, ivec3 gridSize,
+                                             double level, double tolerance,
+                                             bool canParallel, int tileSize) {
+  if (tolerance <= 0) {
+    tolerance = std::numeric_limits<double>::infinity();
+  }
+
+  auto pImpl_ = std::make_shared<Manifold::Impl>();
+
+  const vec3 spacing = bounds.Size() / (vec3(gridSize - 1));
+
+  const ivec3 gridPow(la::log2(gridSize + 2) + 1);
+  const ivec3 numBlocks((gridSize + 2) / kBlockSize + 1);
+  const ivec3 tileBlocks =
+      tileSize > 0 ? la::min(ivec3((tileSize + kBlockSize - 1) / kBlockSize),
+                             numBlocks)
+                   : numBlocks;
+  const ivec3 numTiles = (numBlocks + tileBlocks - 1) / tileBlocks;
+  const Uint64 tileVerts = static_cast<Uint64>(tileBlocks.x + 2) *
+                           (tileBlocks.y + 2) * (tileBlocks.z + 2) *
+                           kBlockVerts;
+
+  // Parallel policies violate will crash language runtimes with runtime locks
+  // that expect to not be called back by unregistered threads. This allows
+  // bindings use LevelSet despite being compiled with MANIFOLD_PAR
+  // active.
+  const auto pol = canParallel ? autoPolicy(tileVerts) : ExecutionPolicy::Seq;
+
+  if (numTiles == ivec3(1)) {
+    TileMesh mesh;
+    MeshTile(mesh, sdf, bound, pol, ivec3(0), numBlocks, bounds.min, spacing,
+             gridSize, gridPow, level, tolerance, false);
+    pImpl_->vertPos_ = std::move(mesh.vertPos);
+    pImpl_->CreateHalfedges(mesh.triVerts);
+  } else {
+    // Each tile is meshed with bounded memory; only the verts and triangles
+    // are accumulated.
+    Vec<vec3> vertPos;
+    Vec<Uint64> vertKey;
+    Vec<ivec3> triVerts;
+    for (int x = 0; x < numTiles.x; ++x) {
+      for (int y = 0; y < numTiles.y; ++y) {
+        for (int z = 0; z < numTiles.z; ++z) {
+          const ivec3 ownMin = ivec3(x, y, z) * tileBlocks;
+          const ivec3 ownMax = la::min(ownMin + tileBlocks, numBlocks);
+          TileMesh mesh;
+          MeshTile(mesh, sdf, bound, pol, ownMin, ownMax, bounds.min, spacing,
+                   gridSize, gridPow, level, tolerance, true);
+          if (mesh.triVerts.empty()) continue;
+          const int firstVert = vertPos.size();
+          const size_t firstTri = triVerts.size();
+          vertPos.resize(firstVert + mesh.vertPos.size());
+          vertKey.resize(firstVert + mesh.vertKey.size());
+          triVerts.resize(firstTri + mesh.triVerts.size());
+          copy(mesh.vertPos.begin(), mesh.vertPos.end(),
+               vertPos.begin() + firstVert);
+          copy(mesh.vertKey.begin(), mesh.vertKey.end(),
+               vertKey.begin() + firstVert);
+          for_each_n(pol, countAt(0_uz), mesh.triVerts.size(), [&](size_t i) {
+            triVerts[firstTri + i] = mesh.triVerts[i] + firstVert;
+          });
+        }
+      }
+    }
+
+    // Verts shared between tiles were computed identically by each, so merge
+    // them by key.
+    const int numVert = vertPos.size();
+    Vec<int> order(numVert);
+    sequence(order.begin(), order.end());
+    stable_sort(order.begin(), order.end(), [&vertKey](int a, int b) {
+      return vertKey[a] < vertKey[b];
+    });
+    Vec<int> newVert(numVert);
+    Vec<int> isFirst(numVert);
+    for_each_n(pol, countAt(0), numVert, [&](int i) {
+      isFirst[i] = i == 0 || vertKey[order[i]] != vertKey[order[i - 1]];
+    });
+    inclusive_scan(isFirst.begin(), isFirst.end(), isFirst.begin());
+    auto& outPos = pImpl_->vertPos_;
+    outPos.resize(numVert > 0 ? isFirst[numVert - 1] : 0);
+    for_each_n(pol, countAt(0), numVert, [&](int i) {
+      newVert[order[i]] = isFirst[i] - 1;
+      if (i == 0 || isFirst[i] != isFirst[i - 1])
+        outPos[isFirst[i] - 1] = vertPos[order[i]];
+    });
+    for_each_n(pol, countAt(0_uz), triVerts.size(), [&](size_t i) {
+      for (const int j : {0, 1, 2}) triVerts[i][j] = newVert[triVerts[i][j]];
+    });
+    pImpl_->CreateHalfedges(triVerts);
+  }
+
+  pImpl_->CleanupTopology();
+  pImpl_->RemoveUnreferencedVerts();
+  pImpl_->Finish();
+  pImpl_->InitializeOriginal();
+  return pImpl_;
+}
 }  // namespace
 
 namespace manifold {
@@ -450,85 +1031,211 @@ namespace manifold {
  * @param canParallel Parallel policies violate will crash language runtimes
  * with runtime locks that expect to not be called back by unregistered threads.
  * This allows bindings use LevelSet despite being compiled with MANIFOLD_PAR
- * active.
+ * active. With the native backend, SetExecutor() can instead run sdf on
+ * threads the runtime knows about.
+ * @param lipschitz If positive, an upper bound on how fast your sdf changes
+ * with distance, e.g. 1 for a true signed-distance function. The grid is then
+ * evaluated in blocks, skipping any block this bound proves is far from the
+ * surface, so that memory and sdf calls scale with surface area rather than
+ * volume. Defaults to 0, which evaluates the whole grid.
+ * @param tileSize If positive, the grid is meshed in cubic tiles of about this
+ * many grid steps per side, one after another, so that working memory is
+ * bounded by the tile rather than the whole grid. The verts along the seams
+ * are computed identically by each tile, so the result is the same single
+ * manifold. Only the grid is bounded: the tiles run sequentially, each using
+ * the parallel policy within itself, and the merged output mesh is still held
+ * fully in memory. Defaults to 0, which meshes the grid all at once.
  */
 Manifold Manifold::LevelSet(std::function<double(vec3)> sdf, Box bounds,
                             double edgeLength, double level, double tolerance,
-                            bool canParallel) {
-  if (tolerance <= 0) {
-    tolerance = std::numeric_limits<double>::infinity();
-  }
-
-  auto pImpl_ = std::make_shared<Impl>();
-  auto& vertPos = pImpl_->vertPos_;
+                            bool canParallel, double lipschitz, int tileSize) {
+  return LevelSetBatch(
+      [&sdf](VecView<const vec3> positions, VecView<double> values) {
+        for (size_t i = 0; i < positions.size(); ++i) {
+          values[i] = sdf(positions[i]);
+        }
+      },
+      bounds, edgeLength, level, tolerance, canParallel, lipschitz, tileSize);
+}
 
-  const vec3 dim = bounds.Size();
-  const ivec3 gridSize(dim / edgeLength + 1.0);
-  const vec3 spacing = dim / (vec3(gridSize - 1));
+/**
+ * Same as Manifold::LevelSet, but calls sdf with a batch of positions at a
+ * time, which greatly reduces the overhead of calling into another language
+ * from bindings. Each call is given contiguous blocks of up to 1024 grid
+ * points, or of the points being refined toward the surface, and must write
+ * the value of each position to the same index of values. Calls may be made
+ * concurrently from multiple threads unless canParallel is false.
+ *
+ * @param sdf A function taking a VecView of positions and a VecView of the
+ * same length to fill with their signed distances.
+ * @param bounds An axis-aligned box that defines the extent of the grid.
+ * @param edgeLength Approximate maximum edge length of the triangles in the
+ * final result.
+ * @param level Extract the surface at this value of your sdf.
+ * @param tolerance Ensure each vertex is within this distance of the true
+ * surface.
+ * @param canParallel Whether sdf may be called from multiple threads.
+ * @param lipschitz If positive, an upper bound on how fast your sdf changes
+ * with distance, used to skip blocks far from the surface.
+ * @param tileSize If positive, mesh the grid sequentially in tiles of about
+ * this many grid steps per side to bound the memory of the grid, though not of
+ * the output mesh.
+ */
+Manifold Manifold::LevelSetBatch(
+    std::function<void(VecView<const vec3>, VecView<double>)> sdf, Box bounds,
+    double edgeLength, double level, double tolerance, bool canParallel,
+    double lipschitz, int tileSize) {
+  BatchBound bound;
+  if (lipschitz > 0) {
+    // The Lipschitz bound from the center of each box.
+    bound = [&sdf, lipschitz](VecView<const Box> boxes, VecView<vec2> range) {
+      std::array<vec3, kBlockVerts> centers;
+      std::array<double, kBlockVerts> values;
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        centers[i] = boxes[i].Center();
+      }
+      sdf(VecView<const vec3>(centers.data(), boxes.size()),
+          VecView<double>(values.data(), boxes.size()));
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        const double radius = 0.5 * la::length(boxes[i].Size()) * lipschitz;
+        range[i] = {values[i] - radius, values[i] + radius};
+      }
+    };
+  }
+  return Manifold(LevelSetImpl(sdf, bound, bounds, GridSize(bounds, edgeLength),
+                               level, tolerance, canParallel, tileSize));
+}
 
-  const ivec3 gridPow(la::log2(gridSize + 2) + 1);
-  const Uint64 maxIndex = EncodeIndex(ivec4(gridSize + 2, 1), gridPow);
+/**
+ * Same as Manifold::LevelSet, but for an SDF expression, which is evaluated
+ * natively in batches. Its interval bounds are used to skip every block of the
+ * grid that is provably entirely inside or outside, so that sdf evaluations
+ * scale with surface area rather than volume.
+ *
+ * @param sdf The SDF expression.
+ * @param bounds An axis-aligned box that defines the extent of the grid.
+ * @param edgeLength Approximate maximum edge length of the triangles in the
+ * final result.
+ * @param level Extract the surface at this value of your sdf.
+ * @param tolerance Ensure each vertex is within this distance of the true
+ * surface.
+ * @param canParallel Whether to evaluate in parallel.
+ * @param tileSize If positive, mesh the grid sequentially in tiles of about
+ * this many grid steps per side to bound the memory of the grid, though not of
+ * the output mesh.
+ */
+Manifold Manifold::LevelSet(const SDF& sdf, Box bounds, double edgeLength,
+                            double level, double tolerance, bool canParallel,
+                            int tileSize) {
+  return Manifold(LevelSetImpl(
+      [&sdf](VecView<const vec3> points, VecView<double> values) {
+        sdf.Evaluate(points, values);
+      },
+      [&sdf](VecView<const Box> boxes, VecView<vec2> range) {
+        for (size_t i = 0; i < boxes.size(); ++i) {
+          range[i] = sdf.Bound(boxes[i]);
+        }
+      },
+      bounds, GridSize(bounds, edgeLength), level, tolerance, canParallel,
+      tileSize));
+}
 
-  // Parallel policies violate will crash language runtimes with runtime locks
-  // that expect to not be called back by unregistered threads. This allows
-  // bindings use LevelSet despite being compiled with MANIFOLD_PAR
-  // active.
-  const auto pol = canParallel ? autoPolicy(maxIndex) : ExecutionPolicy::Seq;
-
-  const vec3 origin = bounds.min;
-  Vec<double> voxels(maxIndex);
-  for_each_n(
-      pol, countAt(0_uz), maxIndex,
-      [&voxels, sdf, level, origin, spacing, gridSize, gridPow](Uint64 idx) {
-        voxels[idx] = BoundedSDF(DecodeIndex(idx, gridPow) - kVoxelOffset,
-                                 origin, spacing, gridSize, level, sdf);
-      });
-
-  size_t tableSize = std::min(
-      2 * maxIndex, static_cast<Uint64>(10 * la::pow(maxIndex, 0.667)));
-  HashTable<GridVert> gridVerts(tableSize);
-  vertPos.resize(gridVerts.Size() * 7);
-
-  while (1) {
-    Vec<int> index(1, 0);
-    for_each_n(pol, countAt(0_uz), EncodeIndex(ivec4(gridSize, 1), gridPow),
-               NearSurface({vertPos, index, gridVerts.D(), voxels, sdf, origin,
-                            gridSize, gridPow, spacing, level, tolerance}));
-
-    if (gridVerts.Full()) {  // Resize HashTable
-      const vec3 lastVert = vertPos[index[0] - 1];
-      const Uint64 lastIndex =
-          EncodeIndex(ivec4(ivec3((lastVert - origin) / spacing), 1), gridPow);
-      const double ratio = static_cast<double>(maxIndex) / lastIndex;
-
-      if (ratio > 1000)  // do not trust the ratio if it is too large
-        tableSize *= 2;
-      else
-        tableSize *= ratio;
-      gridVerts = HashTable<GridVert>(tableSize);
-      vertPos = Vec<vec3>(gridVerts.Size() * 7);
-    } else {  // Success
-      for_each_n(
-          pol, countAt(0), gridVerts.Size(),
-          ComputeVerts({vertPos, index, gridVerts.D(), voxels, sdf, origin,
-                        gridSize, gridPow, spacing, level, tolerance}));
-      vertPos.resize(index[0]);
-      break;
-    }
+/**
+ * Constructs a level-set manifold directly from a volume of samples on a
+ * regular grid, such as CT or other scan data. The level-set grid is aligned to
+ * the samples, so they are read in place as needed rather than resampled
+ * through a callback. Blocks of the grid whose samples all lie on one side of
+ * level are skipped, so only the samples near the surface are interpolated.
+ * The samples may be memory-mapped.
+ *
+ * @param samples The sample values, positive inside, with index (z * dims.y +
+ * y) * dims.x + x, i.e. x varying fastest.
+ * @param dims The number of samples along each axis, each at least 2.
+ * @param spacing The distance between samples along each axis.
+ * @param origin The position of the first sample.
+ * @param level Extract the surface at this sample value.
+ * @param interp How to interpolate between samples: Trilinear is fastest and
+ * never overshoots the samples, while Tricubic (Catmull-Rom) gives a smoother
+ * surface from coarse samples.
+ * @param tolerance Ensure each vertex is within this distance of the true
+ * surface of the interpolated volume.
+ * @param canParallel Whether to evaluate in parallel.
+ * @param tileSize If positive, mesh the grid sequentially in tiles of about
+ * this many grid steps per side to bound the memory of the grid, though not of
+ * the output mesh.
+ */
+Manifold Manifold::LevelSet(VecView<const float> samples, ivec3 dims,
+                            vec3 spacing, vec3 origin, double level,
+                            Interpolation interp, double tolerance,
+                            bool canParallel, int tileSize) {
+  if (la::any(la::less(dims, ivec3(2))) ||
+      samples.size() < static_cast<size_t>(dims.x) * dims.y * dims.z ||
+      la::any(la::lequal(spacing, vec3(0.0)))) {
+    return Invalid();
   }
+  const SampledVolume volume = {samples, dims, origin, spacing, interp};
+  const Box bounds = {origin, origin + spacing * vec3(dims - 1)};
+  return Manifold(LevelSetImpl(
+      volume,
+      [&volume](VecView<const Box> boxes, VecView<vec2> range) {
+        volume.Bound(boxes, range);
+      },
+      bounds, dims, level, tolerance, canParallel, tileSize));
+}
 
-  Vec<ivec3> triVerts(gridVerts.Entries() * 12);  // worst case
-
-  Vec<int> index(1, 0);
-  for_each_n(pol, countAt(0), gridVerts.Size(),
-             BuildTris({triVerts, index, gridVerts.D(), gridPow}));
-  triVerts.resize(index[0]);
+/**
+ * Grows this manifold by delta in every direction, or shrinks it if delta is
+ * negative, by meshing the level set of its signed distance. Convex edges and
+ * corners become rounded with radius delta, while concave ones stay sharp.
+ * Only blocks of the grid near the new surface sample the distance, so the
+ * cost scales with surface area rather than volume. The result is a new mesh
+ * with no properties or relation to the original triangles.
+ *
+ * @param delta The distance to move the surface outward.
+ * @param edgeLength Approximate maximum edge length of the triangles in the
+ * result, as for LevelSet.
+ */
+Manifold Manifold::Offset(double delta, double edgeLength) const {
+  const std::shared_ptr<const Impl> impl = GetCsgLeafNode().GetImpl();
+  if (delta == 0 || impl->IsEmpty()) return *this;
+  if (!(edgeLength > 0)) return Invalid();
+
+  Box bounds = impl->bBox_;
+  const vec3 pad(std::max(delta, 0.0) + edgeLength);
+  bounds = Box(bounds.min - pad, bounds.max + pad);
+  // Blocks are skipped by the distance at their centers, so the distance only
+  // needs to be exact out to a block's reach beyond the new surface.
+  const double maxDistance = std::abs(delta) + 2 * kBlockSize * edgeLength;
+
+  return Manifold(LevelSetImpl(
+      [&impl, maxDistance](VecView<const vec3> points,
+                           VecView<double> values) {
+        for (size_t i = 0; i < points.size(); ++i) {
+          values[i] = impl->SignedDistance(points[i], maxDistance);
+        }
+      },
+      [&impl, maxDistance](VecView<const Box> boxes, VecView<vec2> range) {
+        for (size_t i = 0; i < boxes.size(); ++i) {
+          const double d =
+              impl->SignedDistance(boxes[i].Center(), maxDistance);
+          const double radius = 0.5 * la::length(boxes[i].Size());
+          range[i] = {d - radius, d + radius};
+        }
+      },
+      bounds, GridSize(bounds, edgeLength), -delta, -1, true, 0));
+}
 
-  pImpl_->CreateHalfedges(triVerts);
-  pImpl_->CleanupTopology();
-  pImpl_->RemoveUnreferencedVerts();
-  pImpl_->Finish();
-  pImpl_->InitializeOriginal();
-  return Manifold(pImpl_);
+/**
+ * Hollows this manifold, leaving walls of the given thickness inside its
+ * surface. The outer surface is kept exactly; the inner one is an inward
+ * Offset.
+ *
+ * @param thickness The wall thickness. If not positive, the result is empty.
+ * @param edgeLength Approximate maximum edge length of the triangles of the
+ * inner surface, as for LevelSet.
+ */
+Manifold Manifold::Shell(double thickness, double edgeLength) const {
+  if (!(thickness > 0)) return Manifold();
+  return *this - Offset(-thickness, edgeLength);
 }
 }  // namespace manifold
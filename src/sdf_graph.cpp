@@ -0,0 +1,518 @@
+// Copyright 2026 The Manifold Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+
+#include "./utils.h"
+#include "manifold/sdf.h"
+
+namespace manifold {
+
+/**
+ * A node of an SDF expression. Evaluate fills values for a chunk of at most
+ * kChunk points, and Bound returns an interval {min, max} containing every
+ * value over a box.
+ */
+class SdfNode {
+ public:
+  static constexpr int kChunk = 256;
+  virtual ~SdfNode() = default;
+  virtual void Evaluate(VecView<const vec3> points,
+                        VecView<double> values) const = 0;
+  virtual vec2 Bound(const Box& box) const = 0;
+};
+}  // namespace manifold
+
+namespace {
+using namespace manifold;
+
+using Node = std::shared_ptr<const SdfNode>;
+
+// Interval of an exact (1-Lipschitz) distance over a box, from its center.
+vec2 LipschitzBound(double center, const Box& box) {
+  const double radius = 0.5 * la::length(box.Size());
+  return {center - radius, center + radius};
+}
+
+vec2 IntervalAbs(vec2 a) {
+  if (a.x >= 0) return a;
+  if (a.y <= 0) return {-a.y, -a.x};
+  return {0.0, std::max(-a.x, a.y)};
+}
+
+vec2 IntervalMul(vec2 a, vec2 b) {
+  const vec4 p(a.x * b.x, a.x * b.y, a.y * b.x, a.y * b.y);
+  return {la::minelem(p), la::maxelem(p)};
+}
+
+vec2 IntervalSin(vec2 a) {
+  if (a.y - a.x >= kTwoPi) return {-1.0, 1.0};
+  vec2 out(std::min(sin(a.x), sin(a.y)), std::max(sin(a.x), sin(a.y)));
+  // Is there a peak, at pi/2 + 2 pi n, or trough, at 3 pi/2 + 2 pi n, inside?
+  const double peak = std::ceil((a.x - kHalfPi) / kTwoPi) * kTwoPi + kHalfPi;
+  if (peak <= a.y) out.y = 1.0;
+  const double trough = peak - kPi < a.x ? peak + kPi : peak - kPi;
+  if (trough <= a.y) out.x = -1.0;
+  return out;
+}
+
+vec2 IntervalCos(vec2 a) { return IntervalSin(a + kHalfPi); }
+
+struct Sphere : public SdfNode {
+  double radius;
+  explicit Sphere(double radius) : radius(radius) {}
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = radius - la::length(points[i]);
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    const double near =
+        la::length(la::max(la::max(box.min, -box.max), vec3(0.0)));
+    const double far = la::length(la::max(la::abs(box.min), la::abs(box.max)));
+    return {radius - far, radius - near};
+  }
+};
+
+struct Cube : public SdfNode {
+  vec3 half;
+  explicit Cube(vec3 size) : half(size / 2) {}
+
+  double Distance(vec3 p) const {
+    const vec3 q = la::abs(p) - half;
+    return std::min(la::maxelem(q), 0.0) + la::length(la::max(q, vec3(0.0)));
+  }
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = -Distance(points[i]);
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    return LipschitzBound(-Distance(box.Center()), box);
+  }
+};
+
+struct Cylinder : public SdfNode {
+  double halfHeight;
+  double radius;
+  Cylinder(double height, double radius)
+      : halfHeight(height / 2), radius(radius) {}
+
+  double Distance(vec3 p) const {
+    const vec2 q(la::length(vec2(p.x, p.y)) - radius,
+                 std::abs(p.z) - halfHeight);
+    return std::min(la::maxelem(q), 0.0) + la::length(la::max(q, vec2(0.0)));
+  }
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = -Distance(points[i]);
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    return LipschitzBound(-Distance(box.Center()), box);
+  }
+};
+
+struct Gyroid : public SdfNode {
+  double frequency;
+  explicit Gyroid(double period) : frequency(kTwoPi / period) {}
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    for (size_t i = 0; i < points.size(); ++i) {
+      const vec3 p = frequency * points[i];
+      values[i] = cos(p.x) * sin(p.y) + cos(p.y) * sin(p.z) +
+                  cos(p.z) * sin(p.x);
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    const vec3 lo = frequency * box.min;
+    const vec3 hi = frequency * box.max;
+    vec2 out(0.0);
+    for (const int i : {0, 1, 2}) {
+      const int j = (i + 1) % 3;
+      out += IntervalMul(IntervalCos({lo[i], hi[i]}),
+                         IntervalSin({lo[j], hi[j]}));
+    }
+    return out;
+  }
+};
+
+struct Plane : public SdfNode {
+  vec3 normal;
+  double originOffset;
+  Plane(vec3 normal, double originOffset)
+      : normal(la::normalize(normal)), originOffset(originOffset) {}
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = la::dot(normal, points[i]) - originOffset;
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    const double center = la::dot(normal, box.Center()) - originOffset;
+    const double radius = la::dot(la::abs(normal), box.Size()) / 2;
+    return {center - radius, center + radius};
+  }
+};
+
+enum class BoolOp { Union, Intersection, Difference };
+
+/**
+ * A boolean combination. With a positive radius the sharp max/min is blended
+ * with a quadratic polynomial over the region where the two values are within
+ * radius of each other, which adds at most radius/4 to the result.
+ */
+struct Boolean : public SdfNode {
+  Node a, b;
+  BoolOp op;
+  double radius;
+  Boolean(Node a, Node b, BoolOp op, double radius)
+      : a(a), b(b), op(op), radius(radius) {}
+
+  double Combine(double x, double y) const {
+    if (op == BoolOp::Difference) y = -y;
+    const double h =
+        radius > 0 ? std::max(radius - std::abs(x - y), 0.0) / radius : 0.0;
+    const double blend = h * h * radius / 4;
+    return op == BoolOp::Union ? std::max(x, y) + blend
+                               : std::min(x, y) - blend;
+  }
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    std::array<double, kChunk> other;
+    a->Evaluate(points, values);
+    b->Evaluate(points, VecView<double>(other.data(), points.size()));
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = Combine(values[i], other[i]);
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    const vec2 x = a->Bound(box);
+    vec2 y = b->Bound(box);
+    if (op == BoolOp::Difference) y = -vec2(y.y, y.x);
+    const double blend = std::max(radius, 0.0) / 4;
+    return op == BoolOp::Union
+               ? vec2(std::max(x.x, y.x), std::max(x.y, y.y) + blend)
+               : vec2(std::min(x.x, y.x) - blend, std::min(x.y, y.y));
+  }
+};
+
+struct Offset : public SdfNode {
+  Node child;
+  double distance;
+  Offset(Node child, double distance) : child(child), distance(distance) {}
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    child->Evaluate(points, values);
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] += distance;
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    return child->Bound(box) + distance;
+  }
+};
+
+struct Shell : public SdfNode {
+  Node child;
+  double halfThickness;
+  Shell(Node child, double thickness)
+      : child(child), halfThickness(thickness / 2) {}
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    child->Evaluate(points, values);
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = halfThickness - std::abs(values[i]);
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    const vec2 abs = IntervalAbs(child->Bound(box));
+    return {halfThickness - abs.y, halfThickness - abs.x};
+  }
+};
+
+/**
+ * Evaluates its child at the inverse-transformed point. The value is scaled by
+ * the cube root of the determinant, so that distances remain exact under
+ * rigid transforms and uniform scales.
+ */
+struct Transform : public SdfNode {
+  Node child;
+  mat3x4 inverse;
+  double scale;
+  Transform(Node child, const mat3x4& transform)
+      : child(child),
+        inverse(la::inverse(mat3(transform)),
+                -la::inverse(mat3(transform)) * transform[3]),
+        scale(std::cbrt(std::abs(la::determinant(mat3(transform))))) {}
+
+  void Evaluate(VecView<const vec3> points,
+                VecView<double> values) const override {
+    std::array<vec3, kChunk> local;
+    for (size_t i = 0; i < points.size(); ++i) {
+      local[i] = inverse * vec4(points[i], 1.0);
+    }
+    child->Evaluate(VecView<const vec3>(local.data(), points.size()), values);
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] *= scale;
+    }
+  }
+
+  vec2 Bound(const Box& box) const override {
+    const vec3 center = inverse * vec4(box.Center(), 1.0);
+    const vec3 half = la::mul(la::abs(mat3(inverse)), box.Size() / 2);
+    return scale * child->Bound({center - half, center + half});
+  }
+};
+}  // namespace
+
+namespace manifold {
+
+SDF::SDF(std::shared_ptr<const SdfNode> node) : node_(node) {}
+
+/**
+ * A sphere, which is positive inside.
+ *
+ * @param radius The radius of the sphere.
+ */
+SDF SDF::Sphere(double radius) {
+  return SDF(std::make_shared<::Sphere>(radius));
+}
+
+/**
+ * An axis-aligned box, centered on the origin.
+ *
+ * @param size The length of each side.
+ */
+SDF SDF::Cube(vec3 size) { return SDF(std::make_shared<::Cube>(size)); }
+
+/**
+ * A capped cylinder along the Z-axis, centered on the origin.
+ *
+ * @param height The length along the Z-axis.
+ * @param radius The radius of the cylinder.
+ */
+SDF SDF::Cylinder(double height, double radius) {
+  return SDF(std::make_shared<::Cylinder>(height, radius));
+}
+
+/**
+ * The gyroid function cos(x)sin(y) + cos(y)sin(z) + cos(z)sin(x), with its
+ * argument scaled to the given period. This is not a distance, and ranges
+ * over [-1.5, 1.5]; extract a sheet of it by taking its Shell, or by using a
+ * nonzero level.
+ *
+ * @param period The spatial period of the gyroid along each axis.
+ */
+SDF SDF::Gyroid(double period) {
+  return SDF(std::make_shared<::Gyroid>(period));
+}
+
+/**
+ * A half-space, which is positive on the side the normal points to, matching
+ * what Manifold::TrimByPlane keeps.
+ *
+ * @param normal This vector is normal to the plane; it need not be unit
+ * length.
+ * @param originOffset The distance of the plane from the origin in the
+ * direction of the normal vector.
+ */
+SDF SDF::Plane(vec3 normal, double originOffset) {
+  return SDF(std::make_shared<::Plane>(normal, originOffset));
+}
+
+/**
+ * Union, the maximum of the two values.
+ */
+SDF SDF::operator+(const SDF& other) const {
+  return SDF(
+      std::make_shared<Boolean>(node_, other.node_, BoolOp::Union, 0.0));
+}
+
+/**
+ * Difference, the minimum of this value and the negated other.
+ */
+SDF SDF::operator-(const SDF& other) const {
+  return SDF(
+      std::make_shared<Boolean>(node_, other.node_, BoolOp::Difference, 0.0));
+}
+
+/**
+ * Intersection, the minimum of the two values.
+ */
+SDF SDF::operator^(const SDF& other) const {
+  return SDF(
+      std::make_shared<Boolean>(node_, other.node_, BoolOp::Intersection, 0.0));
+}
+
+/**
+ * Union that fills in the concave edges where the surfaces meet.
+ *
+ * @param other The SDF to combine with.
+ * @param radius Roughly the size of the fillet; the blend only applies where
+ * the two values are within this distance of each other.
+ */
+SDF SDF::SmoothUnion(const SDF& other, double radius) const {
+  return SDF(
+      std::make_shared<Boolean>(node_, other.node_, BoolOp::Union, radius));
+}
+
+/**
+ * Intersection that rounds off the convex edges where the surfaces meet.
+ *
+ * @param other The SDF to combine with.
+ * @param radius Roughly the size of the fillet.
+ */
+SDF SDF::SmoothIntersection(const SDF& other, double radius) const {
+  return SDF(std::make_shared<Boolean>(node_, other.node_,
+                                       BoolOp::Intersection, radius));
+}
+
+/**
+ * Difference that rounds off the edges where the surfaces meet.
+ *
+ * @param other The SDF to subtract.
+ * @param radius Roughly the size of the fillet.
+ */
+SDF SDF::SmoothDifference(const SDF& other, double radius) const {
+  return SDF(std::make_shared<Boolean>(node_, other.node_, BoolOp::Difference,
+                                       radius));
+}
+
+/**
+ * Grows the shape outward by the given distance, or insets it for a negative
+ * distance. This is exact for true distance functions.
+ *
+ * @param distance The distance to offset.
+ */
+SDF SDF::Offset(double distance) const {
+  return SDF(std::make_shared<::Offset>(node_, distance));
+}
+
+/**
+ * A hollow sheet of the given thickness, centered on this surface.
+ *
+ * @param thickness The total thickness of the shell.
+ */
+SDF SDF::Shell(double thickness) const {
+  return SDF(std::make_shared<::Shell>(node_, thickness));
+}
+
+/**
+ * Move this SDF in space.
+ *
+ * @param v The vector to add to every point.
+ */
+SDF SDF::Translate(vec3 v) const {
+  return Transform(mat3x4(la::identity, v));
+}
+
+/**
+ * Applies an Euler angle rotation, in the same order and convention as
+ * Manifold::Rotate.
+ *
+ * @param xDegrees First rotation, degrees about the X-axis.
+ * @param yDegrees Second rotation, degrees about the Y-axis.
+ * @param zDegrees Third rotation, degrees about the Z-axis.
+ */
+SDF SDF::Rotate(double xDegrees, double yDegrees, double zDegrees) const {
+  mat3 rX({1.0, 0.0, 0.0},                        //
+          {0.0, cosd(xDegrees), sind(xDegrees)},  //
+          {0.0, -sind(xDegrees), cosd(xDegrees)});
+  mat3 rY({cosd(yDegrees), 0.0, -sind(yDegrees)},  //
+          {0.0, 1.0, 0.0},                         //
+          {sind(yDegrees), 0.0, cosd(yDegrees)});
+  mat3 rZ({cosd(zDegrees), sind(zDegrees), 0.0},   //
+          {-sind(zDegrees), cosd(zDegrees), 0.0},  //
+          {0.0, 0.0, 1.0});
+  return Transform(mat3x4(rZ * rY * rX, vec3()));
+}
+
+/**
+ * Uniformly scale this SDF, which also scales its values so that it remains a
+ * true distance.
+ *
+ * @param s The scale factor.
+ */
+SDF SDF::Scale(double s) const {
+  return Transform(mat3x4(mat3(la::identity) * s, vec3()));
+}
+
+/**
+ * Transform this SDF in space. The first three columns form a 3x3 matrix
+ * transform and the last is a translation vector. Values are scaled by the cube
+ * root of the determinant, so a non-uniform scale leaves an inexact distance.
+ *
+ * @param m The affine transform matrix to apply to the shape.
+ */
+SDF SDF::Transform(const mat3x4& m) const {
+  return SDF(std::make_shared<::Transform>(node_, m));
+}
+
+/**
+ * Evaluate this SDF at a single point.
+ */
+double SDF::operator()(vec3 point) const {
+  double value;
+  node_->Evaluate(VecView<const vec3>(&point, 1), VecView<double>(&value, 1));
+  return value;
+}
+
+/**
+ * Evaluate this SDF for a batch of points, one node at a time over chunks of
+ * points, which is much faster than calling it point by point. This signature
+ * matches the sdf of Manifold::LevelSetBatch.
+ *
+ * @param points The positions to evaluate.
+ * @param values Filled with the value of each point; must be the same size as
+ * points.
+ */
+void SDF::Evaluate(VecView<const vec3> points, VecView<double> values) const {
+  DEBUG_ASSERT(points.size() == values.size(), userErr,
+               "points and values must be the same size.");
+  for (size_t start = 0; start < points.size(); start += SdfNode::kChunk) {
+    const size_t size =
+        std::min<size_t>(SdfNode::kChunk, points.size() - start);
+    node_->Evaluate(points.view(start, size), values.view(start, size));
+  }
+}
+
+/**
+ * Bounds this SDF's values over the given box by interval arithmetic. The
+ * bounds are conservative, but may be loose.
+ *
+ * @param box The region of space to bound.
+ * @return vec2 The {min, max} values over the box.
+ */
+vec2 SDF::Bound(const Box& box) const { return node_->Bound(box); }
+}  // namespace manifold
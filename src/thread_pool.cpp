@@ -0,0 +1,261 @@
+// Copyright 2025 The Manifold Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+#include "./thread_pool.h"
+
+namespace {
+// Idle workers and waiting threads retry this many times before blocking,
+// since more work usually arrives shortly after a parallel algorithm finishes.
+constexpr int kSpinCount = 64;
+
+// Queues are allocated up front, so that jobs of an executor that was just
+// removed can still safely look at them; executors with more threads than this
+// share queue 0 beyond it.
+constexpr size_t kMaxQueue = 64;
+
+// The calling thread's queue index, 0 outside the pool, along with the pool
+// generation it was assigned in, since indices are handed out anew whenever
+// the executor changes.
+thread_local size_t queueIndex = 0;
+thread_local size_t queueGeneration = 0;
+
+// The isolate() region the calling thread is in, or 0 outside of any.
+thread_local size_t currentIsolation = 0;
+}  // namespace
+
+namespace manifold {
+namespace pool {
+
+size_t ThreadIndex() {
+  static std::atomic<size_t> next{0};
+  thread_local size_t index = next++;
+  return index;
+}
+
+ThreadPool::Isolation::Isolation() : outer_(currentIsolation) {
+  static std::atomic<size_t> next{1};
+  currentIsolation = next++;
+}
+
+ThreadPool::Isolation::~Isolation() { currentIsolation = outer_; }
+
+ThreadPool& ThreadPool::Get() {
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::ThreadPool()
+    : numWorker_(std::max(std::thread::hardware_concurrency(), 1u) - 1) {
+  const size_t numQueue = std::max(numWorker_ + 1, kMaxQueue);
+  for (size_t i = 0; i < numQueue; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+  numQueue_ = numWorker_ + 1;
+  StartWorkers();
+}
+
+ThreadPool::~ThreadPool() { StopWorkers(); }
+
+void ThreadPool::StartWorkers() {
+  for (size_t i = 0; i < numWorker_; ++i)
+    workers_.emplace_back([this, i] { Run(i + 1); });
+  concurrency_ = numWorker_ + 1;
+}
+
+void ThreadPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+  workers_.clear();
+  stop_ = false;
+}
+
+void ThreadPool::SetExecutor(std::shared_ptr<Executor> executor) {
+  if (executor_ == nullptr) StopWorkers();
+  executor_ = std::move(executor);
+  // invalidates the queue index of every thread that ever held one
+  ++generation_;
+  nextQueue_ = 1;
+  if (executor_ == nullptr) {
+    numQueue_ = numWorker_ + 1;
+    StartWorkers();
+  } else {
+    // one queue per executor thread, besides the shared one
+    numQueue_ = std::min(executor_->Concurrency() + 1, queues_.size());
+    concurrency_ = executor_->Concurrency() + 1;
+  }
+}
+
+void ThreadPool::ClaimQueue(size_t generation) {
+  // a job left over from an earlier executor claims nothing
+  if (queueGeneration == generation ||
+      generation != generation_.load(std::memory_order_relaxed))
+    return;
+  // threads beyond the executor's reported concurrency share queue 0
+  const size_t index = nextQueue_.fetch_add(1);
+  queueIndex = index < numQueue_.load() ? index : 0;
+  queueGeneration = generation;
+}
+
+size_t ThreadPool::LocalIndex() const {
+  return queueGeneration == generation_.load(std::memory_order_relaxed)
+             ? queueIndex
+             : 0;
+}
+
+ThreadPool::Queue& ThreadPool::Local() { return *queues_[LocalIndex()]; }
+
+void ThreadPool::Spawn(Task* task) {
+  task->isolation = currentIsolation;
+  Queue& queue = Local();
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+  }
+  queued_.fetch_add(1);
+  // A blocked Wait counts itself as waiting before checking spawned_ under
+  // sleepMutex_, so either it sees this task or it is woken here.
+  spawned_.fetch_add(1);
+  if (waiting_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    done_.notify_all();
+  }
+  if (executor_ != nullptr) {
+    // the job may find the task already taken by a waiting thread, which is
+    // harmless, as it only ever runs what is queued.
+    executor_->Submit([this, generation = generation_.load()] {
+      ClaimQueue(generation);
+      Task* queued = Take();
+      if (queued != nullptr) Execute(queued);
+    });
+    return;
+  }
+  // A worker counts itself as sleeping before checking queued_ under
+  // sleepMutex_, so either it sees this task or it is woken here.
+  if (sleeping_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    wake_.notify_one();
+  }
+}
+
+bool ThreadPool::TryTakeBack(Task* task) {
+  Queue& queue = Local();
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty() || queue.tasks.back() != task) return false;
+  queue.tasks.pop_back();
+  queued_.fetch_sub(1);
+  return true;
+}
+
+Task* ThreadPool::Take() {
+  const size_t region = currentIsolation;
+  auto eligible = [region](const Task* task) {
+    return region == 0 || task->isolation == region;
+  };
+  // newest local work first, as it is likely still in cache. Within a region,
+  // everything this thread spawned since entering it is on top.
+  Queue& local = Local();
+  {
+    std::lock_guard<std::mutex> lock(local.mutex);
+    if (!local.tasks.empty() && eligible(local.tasks.back())) {
+      Task* task = local.tasks.back();
+      local.tasks.pop_back();
+      queued_.fetch_sub(1);
+      return task;
+    }
+  }
+  // then steal the oldest work of another thread, which is the largest
+  const size_t numQueue = numQueue_.load(std::memory_order_relaxed);
+  const size_t index = LocalIndex();
+  for (size_t i = 1; i < numQueue; ++i) {
+    Queue& queue = *queues_[(index + i) % numQueue];
+    std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) continue;
+    auto it = std::find_if(queue.tasks.begin(), queue.tasks.end(), eligible);
+    if (it == queue.tasks.end()) continue;
+    Task* task = *it;
+    queue.tasks.erase(it);
+    queued_.fetch_sub(1);
+    return task;
+  }
+  return nullptr;
+}
+
+void ThreadPool::Execute(Task* task) {
+  // the task may delete itself, and its children belong to its region
+  const size_t outer = currentIsolation;
+  currentIsolation = task->isolation;
+  task->Execute();
+  currentIsolation = outer;
+}
+
+void ThreadPool::Wait(const std::atomic<size_t>& pending) {
+  int idle = 0;
+  while (pending.load() > 0) {
+    const size_t spawned = spawned_.load();
+    Task* task = Take();
+    if (task != nullptr) {
+      Execute(task);
+      idle = 0;
+    } else if (++idle < kSpinCount) {
+      std::this_thread::yield();
+    } else {
+      // everything left is running elsewhere, or belongs to another region
+      std::unique_lock<std::mutex> lock(sleepMutex_);
+      waiting_.fetch_add(1);
+      done_.wait(lock, [&] {
+        return pending.load() == 0 || spawned_.load() != spawned;
+      });
+      waiting_.fetch_sub(1);
+      idle = 0;
+    }
+  }
+}
+
+void ThreadPool::Finish(std::atomic<size_t>& pending) {
+  // pending may be destroyed as soon as it reaches zero, so it is not touched
+  // after the decrement.
+  if (pending.fetch_sub(1) == 1 && waiting_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    done_.notify_all();
+  }
+}
+
+void ThreadPool::Run(size_t index) {
+  queueIndex = index;
+  queueGeneration = generation_.load();
+  int idle = 0;
+  while (!stop_.load()) {
+    Task* task = Take();
+    if (task != nullptr) {
+      Execute(task);
+      idle = 0;
+    } else if (++idle < kSpinCount) {
+      std::this_thread::yield();
+    } else {
+      std::unique_lock<std::mutex> lock(sleepMutex_);
+      sleeping_.fetch_add(1);
+      wake_.wait(lock, [this] { return queued_.load() > 0 || stop_.load(); });
+      sleeping_.fetch_sub(1);
+      idle = 0;
+    }
+  }
+}
+
+}  // namespace pool
+}  // namespace manifold
+#endif
@@ -0,0 +1,651 @@
+// Copyright 2025 The Manifold Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Self-contained parallel backend, selected with MANIFOLD_PAR=NATIVE. It
+// implements the subset of the TBB interface used by parallel.h and the rest of
+// the library, so that code can be written once against `par::`, on top of a
+// work-stealing thread pool.
+//
+// Every thread that waits for tasks executes queued tasks itself until they are
+// done, so progress never depends on the workers, e.g. when Emscripten has not
+// started them yet. Only once there is nothing left to take does it block until
+// its tasks finish or more are spawned.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "manifold/common.h"
+
+namespace manifold {
+namespace pool {
+
+class Task {
+ public:
+  virtual ~Task() = default;
+  virtual void Execute() = 0;
+
+  // The isolate() region the task was spawned in, or 0 outside of any.
+  size_t isolation = 0;
+};
+
+/**
+ * A fixed set of worker threads, one per hardware thread besides the caller,
+ * each with its own deque of tasks. A thread pushes and pops its own tasks at
+ * the back, so it works depth-first on the most recently split range, while
+ * idle threads steal from the front of other deques, where the largest pieces
+ * of work are. Threads outside the pool share an extra deque.
+ *
+ * When the host application supplies an Executor, the workers are stopped and
+ * each spawned task instead submits a job that runs one queued task, so all
+ * the work happens on the caller and the executor's threads. Each executor
+ * thread claims a deque of its own the first time it runs a job, up to the
+ * executor's reported concurrency.
+ */
+class ThreadPool {
+ public:
+  static ThreadPool& Get();
+
+  /// Number of threads that can work at once, including the caller.
+  size_t Concurrency() const {
+    return concurrency_.load(std::memory_order_relaxed);
+  }
+
+  /// Replaces the workers with jobs submitted to executor, or restores them
+  /// if it is null. Must not be called while parallel work is running: the
+  /// workers are joined and restarted, and Spawn reads executor_ unlocked.
+  void SetExecutor(std::shared_ptr<Executor> executor);
+
+  /// Queues a task on the calling thread's deque.
+  void Spawn(Task* task);
+
+  /// Removes task from the back of the calling thread's deque, if it hasn't
+  /// been stolen yet, so the caller can run it directly.
+  bool TryTakeBack(Task* task);
+
+  /// Executes queued tasks until pending reaches zero. Within an isolate()
+  /// region, only tasks spawned in that region are executed.
+  void Wait(const std::atomic<size_t>& pending);
+
+  /// Decrements pending for a finished task, waking threads blocked in Wait.
+  void Finish(std::atomic<size_t>& pending);
+
+  /// While in scope, tasks spawned by the calling thread belong to a new
+  /// isolation region, and its waits only execute tasks from that region.
+  class Isolation {
+   public:
+    Isolation();
+    ~Isolation();
+    Isolation(const Isolation&) = delete;
+    Isolation& operator=(const Isolation&) = delete;
+
+   private:
+    size_t outer_;
+  };
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task*> tasks;
+  };
+
+  ThreadPool();
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  size_t LocalIndex() const;
+  Queue& Local();
+  Task* Take();
+  void Execute(Task* task);
+  void Run(size_t index);
+  void StartWorkers();
+  void StopWorkers();
+  void ClaimQueue(size_t generation);
+
+  const size_t numWorker_;
+  // queues_[0] is shared by threads outside the pool; worker i, or the i-th
+  // executor thread to claim one, owns queues_[i + 1]. Only the first
+  // numQueue_ are in use.
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::atomic<size_t> numQueue_{1};
+  std::atomic<size_t> generation_{1};
+  std::atomic<size_t> nextQueue_{1};
+  std::vector<std::thread> workers_;
+  std::shared_ptr<Executor> executor_;
+  std::atomic<size_t> concurrency_{1};
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> spawned_{0};
+  std::atomic<size_t> sleeping_{0};
+  std::atomic<size_t> waiting_{0};
+  std::atomic<bool> stop_{false};
+  std::mutex sleepMutex_;
+  // idle workers sleep on wake_, blocked Wait calls on done_
+  std::condition_variable wake_;
+  std::condition_variable done_;
+};
+
+/// A small index unique to the calling thread, for per-thread storage.
+size_t ThreadIndex();
+
+namespace details {
+template <typename F>
+class InvokeTask : public Task {
+ public:
+  InvokeTask(const F& f, std::atomic<size_t>& pending)
+      : f_(f), pending_(pending) {}
+
+  void Execute() override {
+    try {
+      f_();
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+    // the waiting thread may destroy this as soon as pending reaches zero
+    ThreadPool::Get().Finish(pending_);
+  }
+
+  std::exception_ptr error_;
+
+ private:
+  const F& f_;
+  std::atomic<size_t>& pending_;
+};
+
+// Ranges are split down to this many pieces per thread, which is enough for
+// work stealing to balance uneven pieces.
+constexpr size_t kPiecesPerThread = 8;
+}  // namespace details
+
+struct split {};
+
+/**
+ * Executes f1 and f2, possibly in parallel, and returns when both are done.
+ * The first exception thrown by either is rethrown.
+ */
+template <typename F1, typename F2>
+void parallel_invoke(const F1& f1, const F2& f2) {
+  ThreadPool& pool = ThreadPool::Get();
+  if (pool.Concurrency() == 1) {
+    f1();
+    f2();
+    return;
+  }
+  std::atomic<size_t> pending(1);
+  details::InvokeTask<F2> task(f2, pending);
+  pool.Spawn(&task);
+  std::exception_ptr error;
+  try {
+    f1();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  if (pool.TryTakeBack(&task)) task.Execute();
+  pool.Wait(pending);
+  if (error) std::rethrow_exception(error);
+  if (task.error_) std::rethrow_exception(task.error_);
+}
+
+template <typename Value>
+class blocked_range {
+ public:
+  using const_iterator = Value;
+  using size_type = size_t;
+
+  blocked_range(Value begin, Value end, size_t grainsize = 1)
+      : begin_(begin), end_(end), grainsize_(grainsize) {}
+  // splits r in half, leaving the first half in r
+  blocked_range(blocked_range& r, split)
+      : begin_(r.begin_ + (r.end_ - r.begin_) / 2),
+        end_(r.end_),
+        grainsize_(r.grainsize_) {
+    r.end_ = begin_;
+  }
+
+  Value begin() const { return begin_; }
+  Value end() const { return end_; }
+  size_t size() const { return static_cast<size_t>(end_ - begin_); }
+  size_t grainsize() const { return grainsize_; }
+  bool empty() const { return !(begin_ < end_); }
+  bool is_divisible() const { return grainsize_ < size(); }
+
+ private:
+  Value begin_;
+  Value end_;
+  size_t grainsize_;
+};
+
+/// Accepted for compatibility; pieces are not pinned to threads.
+struct affinity_partitioner {};
+
+namespace details {
+// Ranges are only split down to the grainsize or to a few pieces per thread,
+// whichever is larger, to keep the number of tasks small.
+template <typename Range>
+size_t LeafSize(const Range& range) {
+  const size_t pieces =
+      ThreadPool::Get().Concurrency() * details::kPiecesPerThread;
+  return std::max(range.grainsize(), (range.size() + pieces - 1) / pieces);
+}
+
+template <typename Range, typename Body>
+void ForRec(Range& range, const Body& body, size_t leafSize) {
+  if (range.size() > leafSize && range.is_divisible()) {
+    Range right(range, split());
+    parallel_invoke([&] { ForRec(range, body, leafSize); },
+                    [&] { ForRec(right, body, leafSize); });
+  } else {
+    body(range);
+  }
+}
+
+template <typename Range, typename Body>
+void ReduceRec(Range& range, Body& body, size_t leafSize) {
+  if (range.size() > leafSize && range.is_divisible()) {
+    Range right(range, split());
+    Body rightBody(body, split());
+    parallel_invoke([&] { ReduceRec(range, body, leafSize); },
+                    [&] { ReduceRec(right, rightBody, leafSize); });
+    body.join(rightBody);
+  } else {
+    body(range);
+  }
+}
+
+template <typename Range, typename T, typename RealBody, typename Reduction>
+struct LambdaReduceBody {
+  T value;
+  const T& identity;
+  const RealBody& realBody;
+  const Reduction& reduction;
+
+  LambdaReduceBody(const T& identity, const RealBody& realBody,
+                   const Reduction& reduction)
+      : value(identity),
+        identity(identity),
+        realBody(realBody),
+        reduction(reduction) {}
+  LambdaReduceBody(LambdaReduceBody& b, split)
+      : value(b.identity),
+        identity(b.identity),
+        realBody(b.realBody),
+        reduction(b.reduction) {}
+  void operator()(const Range& range) { value = realBody(range, value); }
+  void join(LambdaReduceBody& rhs) { value = reduction(value, rhs.value); }
+};
+
+struct pre_scan_tag {
+  static constexpr bool is_final_scan() { return false; }
+};
+
+struct final_scan_tag {
+  static constexpr bool is_final_scan() { return true; }
+};
+
+template <typename Range, typename T, typename Scan, typename Combine>
+struct LambdaScanBody {
+  T sum;
+  const T& identity;
+  const Scan& scan;
+  const Combine& combine;
+
+  LambdaScanBody(const T& identity, const Scan& scan, const Combine& combine)
+      : sum(identity), identity(identity), scan(scan), combine(combine) {}
+  LambdaScanBody(LambdaScanBody& b, split)
+      : sum(b.identity),
+        identity(b.identity),
+        scan(b.scan),
+        combine(b.combine) {}
+  template <typename Tag>
+  void operator()(const Range& range, Tag) {
+    sum = scan(range, sum, Tag::is_final_scan());
+  }
+  void reverse_join(LambdaScanBody& a) { sum = combine(a.sum, sum); }
+  void assign(LambdaScanBody& b) { sum = b.sum; }
+};
+}  // namespace details
+
+/**
+ * Calls body on disjoint pieces of range that together cover it, in parallel.
+ */
+template <typename Range, typename Body>
+void parallel_for(const Range& range, const Body& body) {
+  Range r = range;
+  details::ForRec(r, body, details::LeafSize(r));
+}
+
+template <typename Range, typename Body>
+void parallel_for(const Range& range, const Body& body,
+                  affinity_partitioner&) {
+  parallel_for(range, body);
+}
+
+/**
+ * Reduces range with a Body that can be split, called on pieces of the range,
+ * and joined with the Body of the following piece.
+ */
+template <typename Range, typename Body>
+void parallel_reduce(const Range& range, Body& body) {
+  Range r = range;
+  details::ReduceRec(r, body, details::LeafSize(r));
+}
+
+/**
+ * Reduces range by calling realBody(piece, identity) on each piece and
+ * combining the results in order with reduction.
+ */
+template <typename Range, typename T, typename RealBody, typename Reduction>
+T parallel_reduce(const Range& range, const T& identity,
+                  const RealBody& realBody, const Reduction& reduction) {
+  details::LambdaReduceBody<Range, T, RealBody, Reduction> body(
+      identity, realBody, reduction);
+  parallel_reduce(range, body);
+  return body.value;
+}
+
+/**
+ * Scans range with a Body, in two passes over a few pieces per thread. The
+ * first pass finds the sum of each piece but the first, which is scanned
+ * directly; the second scans each remaining piece starting from the sum of
+ * everything before it. Afterwards body holds the total, as with TBB.
+ */
+template <typename Range, typename Body>
+void parallel_scan(const Range& range, Body& body) {
+  const size_t concurrency = ThreadPool::Get().Concurrency();
+  const size_t n = range.size();
+  const size_t grainsize = std::max<size_t>(range.grainsize(), 1);
+  const size_t numPiece =
+      std::min(concurrency * 4, (n + grainsize - 1) / grainsize);
+  if (concurrency == 1 || numPiece < 2) {
+    body(range, details::final_scan_tag());
+    return;
+  }
+  std::vector<Range> pieces;
+  pieces.reserve(numPiece);
+  for (size_t i = 0; i < numPiece; ++i) {
+    pieces.emplace_back(range.begin() + n * i / numPiece,
+                        range.begin() + n * (i + 1) / numPiece,
+                        range.grainsize());
+  }
+  std::vector<Body> sums;
+  sums.reserve(numPiece);
+  for (size_t i = 0; i < numPiece; ++i) sums.emplace_back(body, split());
+  parallel_for(blocked_range<size_t>(0, numPiece),
+               [&](const blocked_range<size_t>& r) {
+                 for (size_t i = r.begin(); i < r.end(); ++i) {
+                   if (i == 0)
+                     body(pieces[0], details::final_scan_tag());
+                   else
+                     sums[i](pieces[i], details::pre_scan_tag());
+                 }
+               });
+  // sums[i] becomes the sum of pieces [0, i], and scans[i] starts from the sum
+  // of pieces [0, i).
+  std::vector<Body> scans;
+  scans.reserve(numPiece);
+  scans.emplace_back(body, split());
+  Body* prefix = &body;
+  for (size_t i = 1; i < numPiece; ++i) {
+    scans.emplace_back(body, split());
+    scans[i].reverse_join(*prefix);
+    sums[i].reverse_join(*prefix);
+    prefix = &sums[i];
+  }
+  parallel_for(blocked_range<size_t>(1, numPiece),
+               [&](const blocked_range<size_t>& r) {
+                 for (size_t i = r.begin(); i < r.end(); ++i)
+                   scans[i](pieces[i], details::final_scan_tag());
+               });
+  body.assign(scans.back());
+}
+
+/**
+ * Scans range by calling scan(piece, sum, isFinalScan), which returns the sum
+ * after the piece, and combining sums of consecutive pieces with combine.
+ */
+template <typename Range, typename T, typename Scan, typename Combine>
+T parallel_scan(const Range& range, const T& identity, const Scan& scan,
+                const Combine& combine) {
+  details::LambdaScanBody<Range, T, Scan, Combine> body(identity, scan,
+                                                        combine);
+  parallel_scan(range, body);
+  return body.sum;
+}
+
+/**
+ * A copy of T for each thread that calls local(), to be combined afterwards.
+ */
+template <typename T>
+class combinable {
+ public:
+  combinable() : slots_(new std::atomic<T*>[kMaxSlots]) {
+    for (size_t i = 0; i < kMaxSlots; ++i) slots_[i] = nullptr;
+  }
+  ~combinable() {
+    for (size_t i = 0; i < kMaxSlots; ++i) delete slots_[i].load();
+  }
+  combinable(const combinable&) = delete;
+  combinable& operator=(const combinable&) = delete;
+
+  T& local() {
+    const size_t index = ThreadIndex();
+    if (index < kMaxSlots) {
+      // only this thread writes its slot
+      T* slot = slots_[index].load(std::memory_order_relaxed);
+      if (slot == nullptr) {
+        slot = new T();
+        slots_[index].store(slot, std::memory_order_relaxed);
+      }
+      return *slot;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<T>& slot = overflow_[index];
+    if (!slot) slot = std::make_unique<T>();
+    return *slot;
+  }
+
+  template <typename F>
+  void combine_each(F f) {
+    for (size_t i = 0; i < kMaxSlots; ++i) {
+      T* slot = slots_[i].load();
+      if (slot != nullptr) f(*slot);
+    }
+    for (auto& slot : overflow_) f(*slot.second);
+  }
+
+ private:
+  static constexpr size_t kMaxSlots = 256;
+  std::unique_ptr<std::atomic<T*>[]> slots_;
+  std::mutex mutex_;
+  std::map<size_t, std::unique_ptr<T>> overflow_;
+};
+
+/**
+ * A set of tasks that can be waited on together. Tasks may run more tasks in
+ * the same group.
+ */
+class task_group {
+ public:
+  task_group() = default;
+  ~task_group() { ThreadPool::Get().Wait(pending_); }
+  task_group(const task_group&) = delete;
+  task_group& operator=(const task_group&) = delete;
+
+  template <typename F>
+  void run(F&& f) {
+    pending_.fetch_add(1);
+    ThreadPool::Get().Spawn(
+        new GroupTask<std::decay_t<F>>(std::forward<F>(f), *this));
+  }
+
+  void wait() {
+    ThreadPool::Get().Wait(pending_);
+    std::exception_ptr error;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::swap(error, error_);
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+  template <typename F>
+  void run_and_wait(const F& f) {
+    try {
+      f();
+    } catch (...) {
+      SetError(std::current_exception());
+    }
+    wait();
+  }
+
+ private:
+  template <typename F>
+  class GroupTask : public Task {
+   public:
+    GroupTask(F&& f, task_group& group) : f_(std::move(f)), group_(group) {}
+    GroupTask(const F& f, task_group& group) : f_(f), group_(group) {}
+
+    void Execute() override {
+      task_group& group = group_;
+      try {
+        f_();
+      } catch (...) {
+        group.SetError(std::current_exception());
+      }
+      delete this;
+      ThreadPool::Get().Finish(group.pending_);
+    }
+
+   private:
+    F f_;
+    task_group& group_;
+  };
+
+  void SetError(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) error_ = error;
+  }
+
+  std::atomic<size_t> pending_{0};
+  std::mutex mutex_;
+  std::exception_ptr error_;
+};
+
+namespace this_task_arena {
+inline int max_concurrency() {
+  return static_cast<int>(ThreadPool::Get().Concurrency());
+}
+
+/// Runs f such that any waits within it only execute tasks spawned within it,
+/// so a thread never picks up unrelated outer work while inside f.
+template <typename F>
+void isolate(const F& f) {
+  ThreadPool::Isolation isolation;
+  f();
+}
+}  // namespace this_task_arena
+
+/**
+ * A priority queue that can be pushed and popped concurrently. Like
+ * std::priority_queue, the greatest element by Compare is popped first.
+ */
+template <typename T, typename Compare = std::less<T>>
+class concurrent_priority_queue {
+ public:
+  explicit concurrent_priority_queue(size_t capacity = 0) {
+    std::vector<T> storage;
+    storage.reserve(capacity);
+    queue_ = std::priority_queue<T, std::vector<T>, Compare>(
+        Compare(), std::move(storage));
+  }
+
+  void push(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(value);
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.emplace(std::forward<Args>(args)...);
+  }
+
+  bool try_pop(T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) return false;
+    value = queue_.top();
+    queue_.pop();
+    return true;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::priority_queue<T, std::vector<T>, Compare> queue_;
+};
+
+/**
+ * A std::map whose operator[] may be called concurrently. References to its
+ * elements stay valid while others are inserted, but iteration and other
+ * members are not thread-safe.
+ */
+template <typename K, typename V>
+class concurrent_map : public std::map<K, V> {
+ public:
+  V& operator[](const K& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::map<K, V>::operator[](key);
+  }
+
+ private:
+  std::mutex mutex_;
+};
+
+/**
+ * A std::unordered_map whose operator[] may be called concurrently, with the
+ * same caveats as concurrent_map.
+ */
+template <typename K, typename V>
+class concurrent_unordered_map : public std::unordered_map<K, V> {
+ public:
+  V& operator[](const K& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::unordered_map<K, V>::operator[](key);
+  }
+
+ private:
+  std::mutex mutex_;
+};
+
+}  // namespace pool
+}  // namespace manifold
@@ -222,4 +222,55 @@ inline auto DistanceTriangleTriangleSquared(const std::array<vec3, 3>& p,
 
   return shown_disjoint ? mindd : 0.0;
 };
+
+// From Real-Time Collision Detection, Christer Ericson, section 5.1.5, with
+// guards against degenerate triangles.
+
+/**
+ * Returns the point on a triangle closest to a given point.
+ *
+ * @param  p    The query point.
+ * @param  tri  The triangle.
+ */
+inline vec3 ClosestPointOnTriangle(const vec3& p,
+                                   const std::array<vec3, 3>& tri) {
+  const vec3& a = tri[0];
+  const vec3& b = tri[1];
+  const vec3& c = tri[2];
+  const vec3 ab = b - a;
+  const vec3 ac = c - a;
+
+  const vec3 ap = p - a;
+  const double d1 = la::dot(ab, ap);
+  const double d2 = la::dot(ac, ap);
+  if (d1 <= 0.0 && d2 <= 0.0) return a;
+
+  const vec3 bp = p - b;
+  const double d3 = la::dot(ab, bp);
+  const double d4 = la::dot(ac, bp);
+  if (d3 >= 0.0 && d4 <= d3) return b;
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 && d1 > d3)
+    return a + ab * (d1 / (d1 - d3));
+
+  const vec3 cp = p - c;
+  const double d5 = la::dot(ab, cp);
+  const double d6 = la::dot(ac, cp);
+  if (d6 >= 0.0 && d5 <= d6) return c;
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 && d2 > d6)
+    return a + ac * (d2 / (d2 - d6));
+
+  const double va = d3 * d6 - d5 * d4;
+  const double e = d4 - d3;
+  const double f = d5 - d6;
+  if (va <= 0.0 && e >= 0.0 && f >= 0.0 && e + f > 0.0)
+    return b + (c - b) * (e / (e + f));
+
+  const double sum = va + vb + vc;
+  if (sum <= 0.0) return a;
+  return a + ab * (vb / sum) + ac * (vc / sum);
+}
 }  // namespace manifold
@@ -12,6 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "../src/utils.h"
 #include "manifold/manifold.h"
 #include "test.h"
@@ -192,6 +199,366 @@ TEST(Boolean, TreeTransforms) {
   EXPECT_FLOAT_EQ((a + b).Volume(), 2);
 }
 
+TEST(Boolean, TreeSharedSubtrees) {
+  // independent sub-assemblies, some of which are reused in several places of
+  // the tree with different transforms.
+  const Manifold plate = Manifold::Cube({4, 4, 1}) -
+                         Manifold::Cylinder(3, 0.5).Translate({2, 2, -1});
+  const Manifold post = Manifold::Cube({1, 1, 1}).Translate({0, 0, 1});
+  std::vector<Manifold> parts;
+  for (int i = 0; i < 8; ++i) {
+    parts.push_back(plate.Translate({5.0 * i, 0, 0}));
+    parts.push_back((plate + post).Translate({5.0 * i, 5, 0}));
+  }
+  const Manifold assembly = Manifold::BatchBoolean(parts, OpType::Add);
+  const Manifold result = assembly - plate.Translate({0, 0, 0.5});
+
+  const double plateVolume = plate.Volume();
+  const double postVolume = post.Volume();
+  EXPECT_NEAR(assembly.Volume(), 16 * plateVolume + 8 * postVolume, 1e-6);
+  EXPECT_NEAR(result.Volume(),
+              15 * plateVolume + 8 * postVolume + plateVolume / 2, 1e-6);
+  EXPECT_EQ(result.Decompose().size(), 16);
+}
+
+TEST(Boolean, SmallOverlap) {
+  // a small hole drilled near the corner of a finely tessellated block, so
+  // that only a small fraction of it is near the drill.
+  const Manifold block = Manifold::Cube(vec3(10)).Refine(8);
+  const Manifold drill = Manifold::Cylinder(12, 0.5, 0.5, 32).Translate(
+      {1, 1, -1});
+  const Manifold result = block - drill;
+  EXPECT_EQ(result.Status(), Manifold::Error::NoError);
+  EXPECT_EQ(result.Genus(), 1);
+  EXPECT_NEAR(result.Volume(),
+              block.Volume() - (drill ^ Manifold::Cube(vec3(10))).Volume(),
+              1e-6);
+
+  // a void entirely inside, where no face of the block is near the sphere
+  const Manifold sphere = Manifold::Sphere(1, 32).Translate(vec3(5));
+  const Manifold hollow = block - sphere;
+  EXPECT_EQ(hollow.Genus(), -1);
+  EXPECT_NEAR(hollow.Volume(), block.Volume() - sphere.Volume(), 1e-6);
+  EXPECT_TRUE((block ^ sphere).MatchesTriNormals());
+  EXPECT_NEAR((block ^ sphere).Volume(), sphere.Volume(), 1e-6);
+  EXPECT_NEAR((block + sphere).Volume(), block.Volume(), 1e-6);
+}
+
+TEST(Boolean, BatchUnionGrouping) {
+  // mostly disjoint parts with a few overlapping bridges and an empty part
+  const Manifold cube = Manifold::Cube(vec3(0.5), true);
+  const Manifold bar = Manifold::Cube({1.25, 0.25, 0.25}, true);
+  std::vector<Manifold> parts = {Manifold()};
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      parts.push_back(cube.Translate(vec3(i, j, 0)));
+      if (j == 0 && i < 19) parts.push_back(bar.Translate({i + 0.5, 0, 0}));
+    }
+  }
+  const Manifold result = Manifold::BatchBoolean(parts, OpType::Add);
+  const double barOutside = 0.25 * 0.25 * 0.5;
+  EXPECT_NEAR(result.Volume(), 400 * cube.Volume() + 19 * barOutside, 1e-6);
+  EXPECT_EQ(result.Decompose().size(), 400 - 19);
+}
+
+TEST(Boolean, BatchIntersectDisjoint) {
+  const Manifold cube = Manifold::Cube(vec3(1));
+  const Manifold result = Manifold::BatchBoolean(
+      {cube, cube.Translate({0.5, 0, 0}), cube.Translate({2, 0, 0})},
+      OpType::Intersect);
+  EXPECT_TRUE(result.IsEmpty());
+  EXPECT_EQ(result.Status(), Manifold::Error::NoError);
+  EXPECT_NEAR(Manifold::BatchBoolean({cube, cube.Translate({0.5, 0, 0}),
+                                      cube.Translate({0, 0.5, 0})},
+                                     OpType::Intersect)
+                  .Volume(),
+              0.25, 1e-9);
+}
+
+TEST(Boolean, BatchOrder) {
+  // two large plates touching along an edge and a cluster of small, heavily
+  // overlapping spheres
+  std::vector<Manifold> parts;
+  const Manifold plate = Manifold::Cube({10, 10, 1}) -
+                         Manifold::Cylinder(3, 4, 4, 64).Translate({5, 5, -1});
+  parts.push_back(plate);
+  parts.push_back(plate.Translate({9.5, 0, 0}));
+  for (int i = 0; i < 6; ++i)
+    parts.push_back(Manifold::Sphere(1, 32).Translate({0.3 * i, 0.2 * i, 3}));
+
+  const Manifold vertexCount = Manifold::BatchBoolean(parts, OpType::Add);
+  ManifoldParams().batchOrder = BatchOrder::CostModel;
+  const Manifold costModel = Manifold::BatchBoolean(parts, OpType::Add);
+  const Manifold intersection =
+      Manifold::BatchBoolean({parts[2], parts[3], parts[4]}, OpType::Intersect);
+  ManifoldParams().batchOrder = BatchOrder::VertexCount;
+
+  EXPECT_NEAR(costModel.Volume(), vertexCount.Volume(), 1e-6);
+  EXPECT_NEAR(costModel.SurfaceArea(), vertexCount.SurfaceArea(), 1e-6);
+  EXPECT_EQ(costModel.Genus(), vertexCount.Genus());
+  EXPECT_NEAR(intersection.Volume(),
+              Manifold::BatchBoolean({parts[2], parts[3], parts[4]},
+                                     OpType::Intersect)
+                  .Volume(),
+              1e-6);
+}
+
+namespace {
+// A minimal host-side executor, serving jobs from one queue on its own threads.
+class QueueExecutor : public Executor {
+ public:
+  explicit QueueExecutor(int numThread) {
+    for (int i = 0; i < numThread; ++i)
+      threads_.emplace_back([this] {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+          cond_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+          if (jobs_.empty()) return;
+          std::function<void()> job = std::move(jobs_.front());
+          jobs_.pop_front();
+          lock.unlock();
+          job();
+          lock.lock();
+        }
+      });
+  }
+
+  ~QueueExecutor() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    for (std::thread& thread : threads_) thread.join();
+  }
+
+  size_t Concurrency() const override { return threads_.size(); }
+
+  void Submit(std::function<void()> job) override {
+    ++numSubmit;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    cond_.notify_one();
+  }
+
+  std::atomic<int> numSubmit{0};
+
+ private:
+  std::vector<std::thread> threads_;
+  std::deque<std::function<void()>> jobs_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool stop_ = false;
+};
+}  // namespace
+
+TEST(Boolean, Executor) {
+  std::vector<Manifold> parts;
+  for (int i = 0; i < 16; ++i)
+    parts.push_back(Manifold::Sphere(1, 64).Translate({0.4 * i, 0, 0}));
+  const Manifold expected = Manifold::BatchBoolean(parts, OpType::Add);
+
+  auto executor = std::make_shared<QueueExecutor>(3);
+  SetExecutor(executor);
+  // evaluation is lazy, so it must be forced before the executor is removed
+  const Manifold result = Manifold::BatchBoolean(parts, OpType::Add);
+  const double volume = result.Volume();
+  SetExecutor(nullptr);
+
+  EXPECT_NEAR(volume, expected.Volume(), 1e-6);
+  EXPECT_EQ(result.NumTri(), expected.NumTri());
+  EXPECT_EQ(result.Genus(), 0);
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+  EXPECT_GT(executor->numSubmit.load(), 0);
+#endif
+  // the default workers are back
+  EXPECT_NEAR(Manifold::BatchBoolean(parts, OpType::Add).Volume(),
+              expected.Volume(), 1e-6);
+}
+
+namespace {
+// Runs each job immediately inside Submit, on the submitting thread.
+class InlineExecutor : public Executor {
+ public:
+  size_t Concurrency() const override { return 4; }
+
+  void Submit(std::function<void()> job) override {
+    ++numSubmit;
+    job();
+  }
+
+  std::atomic<int> numSubmit{0};
+};
+}  // namespace
+
+TEST(Boolean, BatchCost) {
+  std::vector<Manifold> parts;
+  for (int i = 0; i < 6; ++i)
+    parts.push_back(Manifold::Sphere(1, 32).Translate({0.8 * i, 0, 0}));
+  const double volume = Manifold::BatchBoolean(parts, OpType::Add).Volume();
+
+  // Favoring the most distant pairs first still gives the same union.
+  std::atomic<int> numCall(0);
+  ManifoldParams().batchOrder = BatchOrder::CostModel;
+  ManifoldParams().batchCost = [&numCall](const Manifold& a,
+                                          const Manifold& b) {
+    ++numCall;
+    const Box boxA = a.BoundingBox();
+    const Box boxB = b.BoundingBox();
+    return -la::length(boxA.Center() - boxB.Center());
+  };
+  const double costVolume = Manifold::BatchBoolean(parts, OpType::Add).Volume();
+  ManifoldParams().batchCost = nullptr;
+  ManifoldParams().batchOrder = BatchOrder::VertexCount;
+
+  EXPECT_NEAR(costVolume, volume, 1e-9);
+  // Every initial pair, plus each intermediate result against the rest.
+  EXPECT_GE(numCall, 6 * 5 / 2);
+}
+
+TEST(Boolean, InlineExecutor) {
+  std::vector<Manifold> parts;
+  for (int i = 0; i < 8; ++i)
+    parts.push_back(Manifold::Sphere(1, 64).Translate({0.5 * i, 0, 0}));
+  const Manifold cube = Manifold::Cube({4, 1, 1}, true).Translate({2, 0, 0});
+  const auto sdf = [](vec3 p) { return 1 - la::length(p); };
+  const Box bounds(vec3(-1.1), vec3(1.1));
+
+  ManifoldParams().batchOrder = BatchOrder::CostModel;
+  const double costModel = Manifold::BatchBoolean(parts, OpType::Add).Volume();
+  ManifoldParams().batchOrder = BatchOrder::VertexCount;
+  // independent subtrees are finalized as separate tasks
+  const double tree = ((parts[0] + parts[1]) - (parts[2] ^ cube) +
+                       (parts[5] - parts[6]))
+                          .Volume();
+  const double levelSet =
+      Manifold::LevelSet(sdf, bounds, 0.05, 0, -1, true).Volume();
+
+  auto executor = std::make_shared<InlineExecutor>();
+  SetExecutor(executor);
+  ManifoldParams().batchOrder = BatchOrder::CostModel;
+  const double costModelInline =
+      Manifold::BatchBoolean(parts, OpType::Add).Volume();
+  ManifoldParams().batchOrder = BatchOrder::VertexCount;
+  const double treeInline = ((parts[0] + parts[1]) - (parts[2] ^ cube) +
+                             (parts[5] - parts[6]))
+                                .Volume();
+  const double levelSetInline =
+      Manifold::LevelSet(sdf, bounds, 0.05, 0, -1, true).Volume();
+  SetExecutor(nullptr);
+
+  EXPECT_NEAR(costModelInline, costModel, 1e-6);
+  EXPECT_NEAR(treeInline, tree, 1e-6);
+  EXPECT_NEAR(levelSetInline, levelSet, 1e-6);
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+  EXPECT_GT(executor->numSubmit.load(), 0);
+#endif
+}
+
+#if (MANIFOLD_PAR == 1) && defined(MANIFOLD_PAR_NATIVE)
+namespace {
+// Holds jobs until the test runs them.
+class ManualExecutor : public Executor {
+ public:
+  size_t Concurrency() const override { return 1; }
+
+  void Submit(std::function<void()> job) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+
+  std::function<void()> Pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::function<void()> job = std::move(jobs_.front());
+    jobs_.pop_front();
+    return job;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::deque<std::function<void()>> jobs_;
+};
+}  // namespace
+
+TEST(Boolean, ExecutorIsolate) {
+  auto executor = std::make_shared<ManualExecutor>();
+  SetExecutor(executor);
+  const std::thread::id caller = std::this_thread::get_id();
+  std::atomic<bool> outerQueued(false);
+  std::atomic<bool> ranOnCaller(false);
+  par::task_group outer;
+  std::thread helper;
+  par::this_task_arena::isolate([&] {
+    par::task_group inner;
+    // an executor thread steals the inner task, which keeps the inner wait
+    // pending until an unrelated outer task lies on top of the caller's deque.
+    inner.run([&] {
+      while (!outerQueued) std::this_thread::yield();
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+    helper = std::thread(executor->Pop());
+    std::thread([&] {
+      outer.run([&] {
+        if (std::this_thread::get_id() == caller) ranOnCaller = true;
+      });
+      outerQueued = true;
+    }).join();
+    inner.wait();
+  });
+  helper.join();
+  // only the caller could have run the outer task so far, from the inner wait
+  EXPECT_FALSE(ranOnCaller);
+  outer.wait();
+  SetExecutor(nullptr);
+}
+#endif
+
+TEST(Boolean, Cache) {
+  ClearBooleanCache();
+  ManifoldParams().booleanCacheSize = 1 << 24;
+  const Manifold cube = Manifold::Cube(vec3(2), true);
+  const Manifold sphere = Manifold::Sphere(1.2, 64);
+  const Manifold cylinder = Manifold::Cylinder(3, 0.5, 0.5, 32, true);
+
+  const double volume = ((cube - sphere) + cylinder).Volume();
+  BooleanCacheStats stats = GetBooleanCacheStats();
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.entries, 2);
+
+  // rebuilding the tree reuses both Booleans, a changed part only the first.
+  EXPECT_FLOAT_EQ(((cube - sphere) + cylinder).Volume(), volume);
+  stats = GetBooleanCacheStats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 2);
+  ((cube - sphere) + cylinder.Translate({0.1, 0, 0})).Volume();
+  stats = GetBooleanCacheStats();
+  EXPECT_EQ(stats.hits, 3);
+  EXPECT_EQ(stats.misses, 3);
+
+  EXPECT_EQ(stats.entries, 3);
+
+  // lowering the ceiling evicts right away.
+  const size_t maxMemory = stats.memory / 2;
+  ManifoldParams().booleanCacheSize = maxMemory;
+  stats = GetBooleanCacheStats();
+  EXPECT_GT(stats.evictions, 0);
+  EXPECT_LE(stats.memory, maxMemory);
+
+  // a ceiling smaller than any result disables caching.
+  ManifoldParams().booleanCacheSize = 1;
+  (cube - sphere.Translate({0.2, 0, 0})).Volume();
+  stats = GetBooleanCacheStats();
+  EXPECT_EQ(stats.misses, 4);
+  EXPECT_EQ(stats.entries, 0);
+
+  ManifoldParams().booleanCacheSize = 0;
+  ClearBooleanCache();
+  EXPECT_EQ(GetBooleanCacheStats().entries, 0);
+}
+
 TEST(Boolean, CreatePropertiesSlow) {
   Manifold a = Manifold::Sphere(10, 1024).SetProperties(
       3, [](double* newprop, vec3 pos, const double* old) {
@@ -344,6 +711,74 @@ TEST(Boolean, SplitByPlane60) {
   EXPECT_NEAR(splits.first.Volume(), splits.second.Volume(), 1e-5);
 }
 
+TEST(Boolean, SplitByPlaneProperties) {
+  Manifold sphere =
+      Manifold::Sphere(1.0, 64)
+          .SetProperties(1, [](double* newProp, vec3 pos, const double*) {
+            newProp[0] = pos.x + 2 * pos.y;
+          })
+          .AsOriginal();
+  const uint32_t sphereID = sphere.OriginalID();
+  std::pair<Manifold, Manifold> splits =
+      sphere.SplitByPlane({1.0, 1.0, 1.0}, 0.2);
+  CheckStrictly(splits.first);
+  CheckStrictly(splits.second);
+  EXPECT_NEAR(splits.first.Volume() + splits.second.Volume(), sphere.Volume(),
+              1e-9);
+
+  // The linear property must be interpolated exactly along the cut edges.
+  for (const Manifold& half : {splits.first, splits.second}) {
+    const MeshGL64 mesh = half.GetMeshGL64();
+    ASSERT_EQ(mesh.runOriginalID.size(), 2);
+    for (size_t run = 0; run < 2; ++run) {
+      if (mesh.runOriginalID[run] != sphereID) continue;
+      for (size_t i = mesh.runIndex[run]; i < mesh.runIndex[run + 1]; ++i) {
+        const size_t vert = mesh.triVerts[i];
+        const vec3 pos = mesh.GetVertPos(vert);
+        EXPECT_NEAR(mesh.vertProperties[mesh.numProp * vert + 3],
+                    pos.x + 2 * pos.y, 1e-9);
+      }
+    }
+  }
+
+  Manifold trimmed = sphere.TrimByPlane({0.0, 0.0, 1.0}, 0.3);
+  Manifold intersected =
+      sphere ^ Manifold::Cube({4.0, 4.0, 2.0}).Translate({-2.0, -2.0, 0.3});
+  EXPECT_NEAR(trimmed.Volume(), intersected.Volume(), 1e-9);
+  EXPECT_NEAR(trimmed.SurfaceArea(), intersected.SurfaceArea(), 1e-9);
+
+  // Faces lying on the plane belong to neither side.
+  Manifold cube = Manifold::Cube();
+  EXPECT_FLOAT_EQ(cube.TrimByPlane({0.0, 0.0, 1.0}, 0.0).Volume(), 1.0);
+  EXPECT_TRUE(cube.TrimByPlane({0.0, 0.0, -1.0}, 0.0).IsEmpty());
+}
+
+TEST(Boolean, SplitByPlaneOnVerts) {
+  // The equator verts lie exactly on the plane, so the two sides cut
+  // different edges.
+  const Manifold sphere =
+      Manifold::Sphere(1.0, 64).SetProperties(
+          1, [](double* newProp, vec3 pos, const double*) {
+            newProp[0] = pos.x + 2 * pos.y;
+          });
+  for (const vec3 normal : {vec3(0.0, 0.0, 1.0), vec3(0.0, 0.2, 1.0)}) {
+    const std::pair<Manifold, Manifold> splits =
+        sphere.SplitByPlane(normal, 0.0);
+    const Manifold first = sphere.TrimByPlane(normal, 0.0);
+    const Manifold second = sphere.TrimByPlane(-normal, 0.0);
+    CheckStrictly(splits.first);
+    CheckStrictly(splits.second);
+    EXPECT_EQ(splits.first.NumTri(), first.NumTri());
+    EXPECT_EQ(splits.second.NumTri(), second.NumTri());
+    EXPECT_EQ(splits.first.NumPropVert(), first.NumPropVert());
+    EXPECT_EQ(splits.second.NumPropVert(), second.NumPropVert());
+    EXPECT_NEAR(splits.first.Volume(), first.Volume(), 1e-9);
+    EXPECT_NEAR(splits.second.Volume(), second.Volume(), 1e-9);
+    EXPECT_NEAR(splits.first.Volume() + splits.second.Volume(),
+                sphere.Volume(), 1e-9);
+  }
+}
+
 /**
  * This tests that non-intersecting geometry is properly retained.
  */
@@ -15,10 +15,12 @@
 #include "manifold/manifold.h"
 
 #include <algorithm>
+#include <atomic>
 
 #ifdef MANIFOLD_CROSS_SECTION
 #include "manifold/cross_section.h"
 #endif
+#include "../src/parallel.h"
 #include "../src/tri_dist.h"
 #include "samples.h"
 #include "test.h"
@@ -50,6 +52,20 @@ TEST(Manifold, GetMeshGL) {
   Identical(mesh_out, mesh_out2);
 }
 
+TEST(Manifold, ParallelUnique) {
+  // unique works through the input in chunks of 1 << 16, so these runs of
+  // duplicates cross chunk boundaries, including one spanning a whole chunk.
+  for (const int runLength : {5, 3, 100000}) {
+    std::vector<int> in(300000);
+    for (size_t i = 0; i < in.size(); ++i) in[i] = i / runLength;
+    std::vector<int> expected = in;
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+    in.erase(unique(ExecutionPolicy::Par, in.begin(), in.end()), in.end());
+    EXPECT_EQ(in, expected) << runLength;
+  }
+}
+
 TEST(Manifold, Empty) {
   MeshGL emptyMesh;
   Manifold empty(emptyMesh);
@@ -465,6 +481,59 @@ TEST(Manifold, Slices) {
 }
 #endif
 
+TEST(Manifold, SlicesMatchSlice) {
+  Manifold sphere = Manifold::Sphere(5, 64).Rotate(10, 20, 30);
+  const double bottomZ = -5.5;
+  const double topZ = 5.5;
+  const int nSlices = 23;
+  const double step = (topZ - bottomZ) / (nSlices - 1);
+  std::vector<Polygons> slices = sphere.Slices(bottomZ, topZ, nSlices);
+  std::vector<Polygons> reversed = sphere.Slices(topZ, bottomZ, nSlices);
+  ASSERT_EQ(slices.size(), nSlices);
+  ASSERT_EQ(reversed.size(), nSlices);
+  for (int i = 0; i < nSlices; ++i) {
+    const Polygons slice = sphere.Slice(bottomZ + i * step);
+    ASSERT_EQ(slices[i].size(), slice.size());
+    for (size_t j = 0; j < slice.size(); ++j) {
+      ASSERT_EQ(slices[i][j].size(), slice[j].size());
+      for (size_t k = 0; k < slice[j].size(); ++k) {
+        EXPECT_EQ(slices[i][j][k], slice[j][k]);
+      }
+    }
+    EXPECT_EQ(reversed[nSlices - 1 - i].size(), slice.size());
+  }
+  EXPECT_TRUE(slices.front().empty());
+  EXPECT_TRUE(slices.back().empty());
+  EXPECT_EQ(sphere.Slices(0, 0, 1).size(), 1);
+}
+
+TEST(Manifold, SliceStream) {
+  Manifold sphere = Manifold::Sphere(5, 64);
+  const int nSlices = 600;
+  std::vector<Polygons> slices = sphere.Slices(-5, 5, nSlices);
+  // the slices are swept in batches, so check those around their boundaries
+  const double step = 10.0 / (nSlices - 1);
+  for (const int i : {1, 255, 256, 257, 511, 512, 598})
+    EXPECT_EQ(slices[i], sphere.Slice(-5 + i * step));
+
+  int next = 0;
+  sphere.SliceStream(-5, 5, nSlices, [&](int i, Polygons polys) {
+    EXPECT_EQ(i, next++);
+    EXPECT_EQ(polys, slices[i]);
+  });
+  EXPECT_EQ(next, nSlices);
+
+  std::vector<std::atomic<int>> seen(nSlices);
+  sphere.SliceStream(
+      -5, 5, nSlices,
+      [&](int i, Polygons polys) {
+        seen[i]++;
+        EXPECT_EQ(polys.size(), slices[i].size());
+      },
+      false);
+  for (const auto& count : seen) EXPECT_EQ(count, 1);
+}
+
 TEST(Manifold, GetTriangles) {
   Manifold man = Manifold::Cube();
   std::vector<int> triangles = man.GetTriangles();
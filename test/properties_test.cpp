@@ -110,6 +110,107 @@ TEST(Properties, CalculateCurvature) {
   }
 }
 
+TEST(Properties, Overlaps) {
+  const Manifold cube = Manifold::Cube();
+  EXPECT_TRUE(cube.Overlaps(cube.Translate({0.5, 0.5, 0.5})));
+  EXPECT_TRUE(cube.Overlaps(cube.Translate({1, 0, 0})));
+  EXPECT_FALSE(cube.Overlaps(cube.Translate({1.5, 0, 0})));
+  EXPECT_FALSE(cube.Overlaps(cube.Translate({1.5, 1.5, 0.5})));
+
+  const Manifold big = Manifold::Cube(vec3(4), true);
+  const Manifold sphere = Manifold::Sphere(1, 32);
+  EXPECT_TRUE(big.Overlaps(sphere));
+  EXPECT_TRUE(sphere.Overlaps(big));
+  EXPECT_FALSE((big - Manifold::Cube(vec3(3), true)).Overlaps(sphere));
+  EXPECT_FALSE(cube.Overlaps(Manifold()));
+}
+
+TEST(Properties, OverlapsTransform) {
+  const Manifold a = Manifold::Cube(vec3(1), true);
+  const Manifold b = Manifold::Cylinder(2, 0.3, 0.3, 16);
+  int numOverlap = 0;
+  size_t numEdgeOverlap = 0;
+  for (int i = 0; i < 20; ++i) {
+    const mat3 rotation =
+        la::qmat(la::rotation_quat(la::normalize(vec3(1, 2, 3 + i)), 0.3 * i));
+    const mat3x4 transform(rotation, vec3(0.1 * i - 1, 0.6, 0.02 * i));
+    const Manifold moved = b.Transform(transform);
+    const bool overlaps = a.Overlaps(b, transform);
+    EXPECT_EQ(overlaps, a.Overlaps(moved)) << i;
+    numOverlap += overlaps;
+    EXPECT_NEAR(a.MinGap(b, 1, transform), a.MinGap(moved, 1), 1e-9) << i;
+    const size_t numEdge = a.NumOverlaps(b, transform);
+    EXPECT_EQ(numEdge, a.NumOverlaps(moved)) << i;
+    numEdgeOverlap += numEdge;
+  }
+  EXPECT_GT(numOverlap, 0);
+  EXPECT_LT(numOverlap, 20);
+  EXPECT_GT(numEdgeOverlap, 0);
+}
+
+TEST(Properties, OverlapsTransformLarge) {
+  // Large enough for the joint traversal to run in parallel.
+  const Manifold a = Manifold::Sphere(1, 128);
+  const Manifold b = Manifold::Sphere(0.8, 128);
+  for (const double x : {0.5, 1.7, 2.1}) {
+    const mat3x4 transform(la::identity, vec3(x, 0.1, 0));
+    const Manifold moved = b.Transform(transform);
+    EXPECT_EQ(a.Overlaps(b, transform), a.Overlaps(moved)) << x;
+    EXPECT_EQ(a.NumOverlaps(b, transform), a.NumOverlaps(moved)) << x;
+  }
+}
+
+TEST(Properties, OverlapsSingularTransform) {
+  const Manifold small = Manifold::Cube(vec3(0.5), true);
+  const Manifold big = Manifold::Cube(vec3(4), true);
+  // Flattens big into a square in the z = z0 plane.
+  auto flatten = [](double z0) {
+    return mat3x4(mat3({1, 0, 0}, {0, 1, 0}, {0, 0, 0}), vec3(0, 0, z0));
+  };
+  EXPECT_TRUE(small.Overlaps(big, flatten(0)));
+  EXPECT_FALSE(small.Overlaps(big, flatten(1)));
+  EXPECT_NEAR(small.MinGap(big, 1, flatten(1)), 0.75, 1e-9);
+  EXPECT_EQ(small.NumOverlaps(big, flatten(1)), 0);
+  EXPECT_GT(small.NumOverlaps(big, flatten(0)), 0);
+}
+
+TEST(Properties, PairwiseOverlaps) {
+  // A jittered grid of spheres, so some pairs overlap, some are within the
+  // clearance and the rest are further apart.
+  std::vector<Manifold> parts;
+  for (int i = 0; i < 64; ++i) {
+    const vec3 jitter(std::sin(i * 1.7), std::cos(i * 2.3), std::sin(i * 3.1));
+    parts.push_back(Manifold::Sphere(0.5, 16).Translate(
+        vec3(i % 4, (i / 4) % 4, i / 16) * 1.1 + 0.15 * jitter));
+  }
+  parts.push_back(Manifold());
+  const double clearance = 0.2;
+  const std::vector<Interference> pairs =
+      Manifold::PairwiseOverlaps(parts, clearance);
+
+  size_t k = 0;
+  size_t numOverlap = 0;
+  for (size_t i = 0; i < parts.size(); ++i) {
+    for (size_t j = i + 1; j < parts.size(); ++j) {
+      const double gap = parts[i].MinGap(parts[j], clearance);
+      if (gap >= clearance) continue;
+      ASSERT_LT(k, pairs.size());
+      EXPECT_EQ(pairs[k].first, i);
+      EXPECT_EQ(pairs[k].second, j);
+      EXPECT_NEAR(pairs[k].distance, gap, 1e-9);
+      numOverlap += pairs[k].distance == 0;
+      ++k;
+    }
+  }
+  EXPECT_EQ(k, pairs.size());
+  EXPECT_GT(numOverlap, 0);
+  EXPECT_LT(numOverlap, pairs.size());
+
+  const std::vector<Interference> overlaps = Manifold::PairwiseOverlaps(parts);
+  EXPECT_EQ(overlaps.size(), numOverlap);
+  for (const Interference& pair : overlaps) EXPECT_EQ(pair.distance, 0);
+}
+
 // These tests verify the calculation of MinGap functions.
 
 TEST(Properties, MinGapCubeCube) {
@@ -259,3 +360,162 @@ TEST(Properties, TriangleDistanceOverlapping) {
 
   EXPECT_FLOAT_EQ(distance, 0);
 }
+
+TEST(Properties, SignedDistanceCube) {
+  const Manifold cube = Manifold::Cube(vec3(2), true);
+  // The +z ray from the center runs along a diagonal of the top face.
+  EXPECT_DOUBLE_EQ(cube.SignedDistance({0, 0, 0}), 1);
+  EXPECT_DOUBLE_EQ(cube.SignedDistance({0.5, 0.5, 0.5}), 0.5);
+  EXPECT_DOUBLE_EQ(cube.SignedDistance({2, 0, 0}), -1);
+  EXPECT_DOUBLE_EQ(cube.SignedDistance({2, 2, 0}), -sqrt(2));
+  EXPECT_DOUBLE_EQ(cube.SignedDistance({0, 0, -3}), -2);
+  EXPECT_DOUBLE_EQ(cube.SignedDistance({5, 0, 0}, 1), -1);
+  EXPECT_DOUBLE_EQ(cube.SignedDistance({0, 0, 0}, 0.5), 0.5);
+
+  std::vector<vec3> points;
+  for (int i = -6; i <= 6; ++i)
+    for (int j = -6; j <= 6; ++j)
+      for (int k = -6; k <= 6; ++k) points.push_back(vec3(i, j, k) * 0.25);
+  std::vector<double> distances(points.size());
+  cube.SignedDistance(points,
+                      VecView<double>(distances.data(), distances.size()));
+  for (size_t i = 0; i < points.size(); ++i) {
+    const vec3 d = la::abs(points[i]) - vec3(1);
+    const double outside = la::length(la::max(d, vec3(0.0)));
+    const double inside = std::min(la::maxelem(d), 0.0);
+    EXPECT_NEAR(distances[i], -(outside + inside), 1e-12)
+        << points[i].x << ' ' << points[i].y << ' ' << points[i].z;
+  }
+}
+
+TEST(Properties, SignedDistanceOffset) {
+  const Manifold cube = Manifold::Cube(vec3(2), true);
+  const double r = 0.5;
+  const Manifold offset = Manifold::LevelSetBatch(
+      [&](VecView<const vec3> points, VecView<double> values) {
+        cube.SignedDistance(points, values);
+      },
+      {vec3(-2), vec3(2)}, 0.05, -r);
+  EXPECT_EQ(offset.Status(), Manifold::Error::NoError);
+  EXPECT_EQ(offset.Genus(), 0);
+  const double volume = 8 + 6 * 4 * r + 3 * kPi * r * r * 2 +
+                        4.0 / 3 * kPi * r * r * r;
+  EXPECT_NEAR(offset.Volume(), volume, 0.01 * volume);
+}
+
+TEST(Properties, RayCastCube) {
+  const Manifold cube = Manifold::Cube(vec3(2), true);
+  std::vector<vec3> origins;
+  std::vector<vec3> directions;
+  // Along face diagonals and through verts.
+  for (int i = -4; i <= 4; ++i) {
+    origins.push_back(vec3(i * 0.25, i * 0.25, -5));
+    directions.push_back(vec3(0, 0, 2));
+  }
+  origins.push_back(vec3(0, 0, 0));
+  directions.push_back(vec3(1, 1, 1));
+  origins.push_back(vec3(3, 0, 0));
+  directions.push_back(vec3(0, 1, 0));
+  const std::vector<RayHit> hits = cube.RayCast(origins, directions);
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_DOUBLE_EQ(hits[i].distance, 2);
+    EXPECT_EQ(hits[i].normal, vec3(0, 0, -1));
+    EXPECT_NEAR(la::sum(hits[i].barycentric), 1, 1e-12);
+  }
+  EXPECT_DOUBLE_EQ(hits[9].distance, 1);
+  EXPECT_EQ(hits[10].distance, std::numeric_limits<double>::infinity());
+  EXPECT_EQ(hits[10].faceID, -1);
+
+  // The IDs are those GetMeshGL() reports, even after a Boolean.
+  const Manifold cut = cube - cube.Translate(vec3(1.5, 0, 0));
+  const MeshGL mesh = cut.GetMeshGL();
+  const RayHit hit = cut.RayCast({&origins[4], 1}, {&directions[4], 1})[0];
+  EXPECT_DOUBLE_EQ(hit.distance, 2);
+  EXPECT_EQ(hit.originalID, cube.OriginalID());
+  EXPECT_NE(std::find(mesh.faceID.begin(), mesh.faceID.end(), hit.faceID),
+            mesh.faceID.end());
+}
+
+TEST(Properties, RayCastSphere) {
+  const Manifold sphere = Manifold::Sphere(1, 64);
+  std::vector<vec3> directions;
+  for (int i = 0; i < 32; ++i)
+    for (int j = 0; j <= 16; ++j) {
+      const double theta = i * kTwoPi / 32;
+      const double phi = j * kPi / 16;
+      directions.push_back(vec3(std::cos(theta) * std::sin(phi),
+                                std::sin(theta) * std::sin(phi),
+                                std::cos(phi)));
+    }
+  const std::vector<vec3> origins(directions.size(), vec3(0.0));
+  const std::vector<RayHit> hits = sphere.RayCast(origins, directions);
+  for (const RayHit& hit : hits) {
+    EXPECT_NEAR(hit.distance, 1, 0.01);
+    EXPECT_GE(hit.faceID, 0);
+  }
+}
+
+TEST(Properties, RayCastBarycentric) {
+  MeshGL tet;
+  tet.numProp = 3;
+  tet.vertProperties = {0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1};
+  tet.triVerts = {0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3};
+  const Manifold manifold(tet);
+  const vec3 origin(0.2, 0.3, 2);
+  const vec3 direction(0, 0, -1);
+  const RayHit hit = manifold.RayCast({&origin, 1}, {&direction, 1})[0];
+  ASSERT_EQ(hit.faceID, 3);
+  EXPECT_EQ(hit.originalID, manifold.GetMeshGL().runOriginalID[0]);
+  vec3 point(0.0);
+  for (const int i : {0, 1, 2}) {
+    const int vert = tet.triVerts[3 * hit.faceID + i];
+    point += hit.barycentric[i] * vec3(tet.vertProperties[3 * vert],
+                                       tet.vertProperties[3 * vert + 1],
+                                       tet.vertProperties[3 * vert + 2]);
+  }
+  EXPECT_NEAR(la::distance(point, origin + hit.distance * direction), 0,
+              1e-12);
+  EXPECT_NEAR(hit.distance, 1.5, 1e-12);
+}
+
+TEST(Properties, Contains) {
+  const Manifold cube = Manifold::Cube(vec3(2), true);
+  std::vector<vec3> points;
+  for (int i = -6; i <= 6; ++i)
+    for (int j = -6; j <= 6; ++j)
+      for (int k = -6; k <= 6; ++k) points.push_back(vec3(i, j, k) * 0.25);
+  const std::vector<Containment> result = cube.Contains(points);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const double d = la::maxelem(la::abs(points[i]));
+    const Containment expected = d < 1   ? Containment::Inside
+                                 : d > 1 ? Containment::Outside
+                                         : Containment::Surface;
+    EXPECT_EQ(result[i], expected)
+        << points[i].x << ' ' << points[i].y << ' ' << points[i].z;
+  }
+}
+
+TEST(Properties, ClosestPoints) {
+  const Manifold cube = Manifold::Cube(vec3(2), true);
+  const std::vector<vec3> points = {
+      {3, 0, 0}, {2, 2, 2}, {0.5, 0, 0.25}, {0, -1, 0.5}};
+  const std::vector<SurfacePoint> closest = cube.ClosestPoints(points);
+  EXPECT_EQ(closest[0].position, vec3(1, 0, 0));
+  EXPECT_DOUBLE_EQ(closest[0].distance, 2);
+  EXPECT_EQ(closest[0].normal, vec3(1, 0, 0));
+  EXPECT_EQ(closest[1].position, vec3(1, 1, 1));
+  EXPECT_DOUBLE_EQ(closest[1].distance, sqrt(3));
+  EXPECT_EQ(closest[2].position, vec3(1, 0, 0.25));
+  EXPECT_EQ(closest[2].normal, vec3(1, 0, 0));
+  EXPECT_DOUBLE_EQ(closest[3].distance, 0);
+  EXPECT_EQ(closest[3].normal, vec3(0, -1, 0));
+  for (const SurfacePoint& point : closest) {
+    EXPECT_GE(point.faceID, 0);
+    EXPECT_EQ(point.originalID, closest[0].originalID);
+  }
+
+  const std::vector<SurfacePoint> near = cube.ClosestPoints(points, 1);
+  EXPECT_EQ(near[0].distance, std::numeric_limits<double>::infinity());
+  EXPECT_EQ(near[0].faceID, -1);
+  EXPECT_DOUBLE_EQ(near[2].distance, 0.5);
+}
@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+
+#include "../src/hashtable.h"
 #include "manifold/manifold.h"
+#include "manifold/sdf.h"
 #include "test.h"
 
 using namespace manifold;
@@ -179,6 +183,201 @@ TEST(SDF, Resize) {
   EXPECT_NEAR(bounds.max.z, size - 1.5, epsilon);
 }
 
+TEST(SDF, Lipschitz) {
+  std::atomic<int> calls = 0;
+  auto torus = [&calls](vec3 pos) {
+    ++calls;
+    const vec2 ring(la::length(vec2(pos.x, pos.y)) - 4, pos.z);
+    return 1 - la::length(ring);
+  };
+  const Box bounds = {vec3(-6), vec3(6)};
+
+  Manifold dense = Manifold::LevelSet(torus, bounds, 0.1);
+  const int denseCalls = calls.exchange(0);
+  Manifold sparse = Manifold::LevelSet(torus, bounds, 0.1, 0, -1, true, 1);
+  const int sparseCalls = calls.exchange(0);
+
+  EXPECT_EQ(sparse.Status(), Manifold::Error::NoError);
+  EXPECT_EQ(sparse.Genus(), 1);
+  EXPECT_EQ(sparse.NumTri(), dense.NumTri());
+  EXPECT_NEAR(sparse.Volume(), dense.Volume(), 1e-9);
+  EXPECT_LT(sparseCalls, denseCalls / 3);
+
+  // The bounds must still close the surface.
+  const Box half = {vec3(-6), vec3(6, 6, 0)};
+  Manifold denseHalf = Manifold::LevelSet(torus, half, 0.1);
+  Manifold sparseHalf = Manifold::LevelSet(torus, half, 0.1, 0, -1, true, 1);
+  EXPECT_EQ(sparseHalf.Genus(), 1);
+  EXPECT_EQ(sparseHalf.NumTri(), denseHalf.NumTri());
+  EXPECT_NEAR(sparseHalf.Volume(), denseHalf.Volume(), 1e-9);
+}
+
+TEST(SDF, Batch) {
+  auto sphere = [](vec3 pos) { return 1 - la::length(pos); };
+  std::atomic<int> maxBatch = 0;
+  auto batch = [&](VecView<const vec3> positions, VecView<double> values) {
+    ASSERT_EQ(positions.size(), values.size());
+    int size = positions.size();
+    int prev = maxBatch.load();
+    while (size > prev && !maxBatch.compare_exchange_weak(prev, size)) {
+    }
+    for (size_t i = 0; i < positions.size(); ++i) {
+      values[i] = sphere(positions[i]);
+    }
+  };
+  const Box bounds = {vec3(-1.5), vec3(1.5)};
+
+  for (const double tolerance : {-1.0, 1e-6}) {
+    Manifold single = Manifold::LevelSet(sphere, bounds, 0.1, 0, tolerance);
+    Manifold batched =
+        Manifold::LevelSetBatch(batch, bounds, 0.1, 0, tolerance);
+    EXPECT_EQ(batched.Genus(), 0);
+    EXPECT_EQ(batched.NumTri(), single.NumTri());
+    EXPECT_NEAR(batched.Volume(), single.Volume(), 1e-9);
+  }
+  EXPECT_GT(maxBatch, 1);
+  EXPECT_LE(maxBatch, 1024);
+}
+
+TEST(SDF, Tiled) {
+  auto torus = [](vec3 pos) {
+    const vec2 ring(la::length(vec2(pos.x, pos.y)) - 4, pos.z);
+    return 1 - la::length(ring);
+  };
+  // The upper bound cuts through the torus, so tiles must also close it.
+  const Box bounds = {vec3(-6), vec3(6, 6, 0.5)};
+
+  Manifold whole = Manifold::LevelSet(torus, bounds, 0.2);
+  for (const int tileSize : {8, 13, 40}) {
+    Manifold tiled =
+        Manifold::LevelSet(torus, bounds, 0.2, 0, -1, true, 0, tileSize);
+    EXPECT_EQ(tiled.Status(), Manifold::Error::NoError);
+    EXPECT_EQ(tiled.Genus(), 1);
+    EXPECT_EQ(tiled.NumVert(), whole.NumVert());
+    EXPECT_EQ(tiled.NumTri(), whole.NumTri());
+    EXPECT_NEAR(tiled.Volume(), whole.Volume(), 1e-9);
+    EXPECT_NEAR(tiled.SurfaceArea(), whole.SurfaceArea(), 1e-9);
+  }
+
+  Manifold sparse =
+      Manifold::LevelSet(torus, bounds, 0.2, 0, -1, true, 1, 16);
+  EXPECT_EQ(sparse.NumTri(), whole.NumTri());
+  EXPECT_NEAR(sparse.Volume(), whole.Volume(), 1e-9);
+}
+
+TEST(SDF, Volume) {
+  const ivec3 dims(41, 41, 31);
+  const vec3 spacing(0.5, 0.5, 0.7);
+  const vec3 origin(-10, -10, -10.5);
+  std::vector<float> samples;
+  for (int z = 0; z < dims.z; ++z) {
+    for (int y = 0; y < dims.y; ++y) {
+      for (int x = 0; x < dims.x; ++x) {
+        const vec3 pos = origin + spacing * vec3(x, y, z);
+        samples.push_back(100 - la::dot(pos, pos));
+      }
+    }
+  }
+  const double sphere = 4.0 / 3 * kPi * 8 * 8 * 8;
+
+  Manifold trilinear = Manifold::LevelSet(samples, dims, spacing, origin, 36);
+  EXPECT_EQ(trilinear.Status(), Manifold::Error::NoError);
+  EXPECT_EQ(trilinear.Genus(), 0);
+  EXPECT_NEAR(trilinear.Volume(), sphere, 0.01 * sphere);
+  const Box box = trilinear.BoundingBox();
+  EXPECT_NEAR(box.max.x, 8, 0.01);
+  EXPECT_NEAR(box.min.z, -8, 0.01);
+
+  Manifold tiled = Manifold::LevelSet(samples, dims, spacing, origin, 36,
+                                      Interpolation::Trilinear, -1, true, 16);
+  EXPECT_EQ(tiled.NumTri(), trilinear.NumTri());
+  EXPECT_NEAR(tiled.Volume(), trilinear.Volume(), 1e-9);
+
+  Manifold tricubic = Manifold::LevelSet(samples, dims, spacing, origin, 36,
+                                         Interpolation::Tricubic);
+  EXPECT_EQ(tricubic.Status(), Manifold::Error::NoError);
+  EXPECT_EQ(tricubic.Genus(), 0);
+  EXPECT_NEAR(tricubic.Volume(), sphere, 0.005 * sphere);
+
+  EXPECT_EQ(Manifold::LevelSet(samples, ivec3(41, 41, 1), spacing).Status(),
+            Manifold::Error::InvalidConstruction);
+}
+
+TEST(SDF, Graph) {
+  const SDF shape = (SDF::Cube(vec3(4)) ^ SDF::Sphere(2.6))
+                        .SmoothDifference(SDF::Cylinder(6, 1).Rotate(90), 0.2)
+                        .Translate(vec3(0.5));
+  const Box bounds = {vec3(-2.5), vec3(3.5)};
+
+  std::atomic<int> calls = 0;
+  Manifold dense = Manifold::LevelSet(
+      [&](vec3 p) {
+        ++calls;
+        return shape(p);
+      },
+      bounds, 0.1);
+  Manifold sparse = Manifold::LevelSet(shape, bounds, 0.1);
+
+  EXPECT_EQ(sparse.Status(), Manifold::Error::NoError);
+  EXPECT_EQ(sparse.Genus(), 1);
+  EXPECT_EQ(sparse.NumTri(), dense.NumTri());
+  EXPECT_NEAR(sparse.Volume(), dense.Volume(), 1e-9);
+
+  std::vector<vec3> points(calls);
+  std::vector<double> values(points.size());
+  for (size_t i = 0; i < points.size(); ++i) points[i] = vec3(i * 1e-4);
+  shape.Evaluate(points, VecView<double>(values.data(), values.size()));
+  for (size_t i = 0; i < points.size(); i += 997) {
+    EXPECT_EQ(values[i], shape(points[i]));
+  }
+}
+
+TEST(SDF, GraphBound) {
+  const SDF shape =
+      (SDF::Gyroid(3).Shell(0.5) ^ SDF::Plane(vec3(1, 1, 0), 0.5))
+          .SmoothUnion(SDF::Sphere(1).Scale(1.5), 0.3)
+          .Offset(0.1)
+          .Rotate(20, 30, 40);
+  const int n = 10;
+  for (const Box box : {Box(vec3(-0.3), vec3(0.2)), Box(vec3(1), vec3(2.5)),
+                        Box(vec3(-4, 2, 0), vec3(-3.5, 3, 0.1))}) {
+    const vec2 range = shape.Bound(box);
+    for (int i = 0; i <= n; ++i) {
+      for (int j = 0; j <= n; ++j) {
+        for (int k = 0; k <= n; ++k) {
+          const double d =
+              shape(box.min + box.Size() * vec3(i, j, k) / double(n));
+          EXPECT_GE(d, range.x - 1e-12);
+          EXPECT_LE(d, range.y + 1e-12);
+        }
+      }
+    }
+  }
+  // A box far from the sphere is bounded to one side.
+  EXPECT_LT(SDF::Sphere(1).Bound({vec3(2), vec3(3)}).y, 0);
+  EXPECT_GT(SDF::Sphere(3).Bound({vec3(-0.5), vec3(0.5)}).x, 0);
+}
+
+TEST(SDF, HashTableReserve) {
+  HashTable<int> table(16);
+  int inserted = 0;
+  for (int i = 0; i < 20; ++i) inserted += table.D().Insert(i * 7919, i);
+  EXPECT_EQ(inserted, 9);
+  EXPECT_EQ(table.Room(), 0);
+
+  table.Reserve(100);
+  EXPECT_GE(table.Room(), 100);
+  auto d = table.D();
+  for (int i = 0; i < 100; ++i) EXPECT_TRUE(d.Insert(i * 7919, i));
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(d[i * 7919], i);
+
+  const HashTableStats stats = table.Stats();
+  EXPECT_EQ(stats.entries, 100);
+  EXPECT_EQ(stats.capacity, table.Size());
+  EXPECT_LE(stats.loadFactor, 0.5);
+  EXPECT_LE(stats.meanProbe, stats.maxProbe);
+}
+
 TEST(SDF, SineSurface) {
   Manifold surface =
       Manifold::LevelSet(
@@ -231,3 +430,23 @@ TEST(SDF, Blobs) {
   if (options.exportModels) ExportMesh("blobs.glb", blobs.GetMeshGL(), {});
 #endif
 }
+
+TEST(SDF, Offset) {
+  const Manifold cube = Manifold::Cube(vec3(2), true);
+  const double r = 0.5;
+  const Manifold grown = cube.Offset(r, 0.05);
+  EXPECT_EQ(grown.Status(), Manifold::Error::NoError);
+  EXPECT_EQ(grown.Genus(), 0);
+  const double volume =
+      8 + 6 * 4 * r + 3 * kPi * r * r * 2 + 4.0 / 3 * kPi * r * r * r;
+  EXPECT_NEAR(grown.Volume(), volume, 0.01 * volume);
+
+  const Manifold shrunk = cube.Offset(-r, 0.05);
+  EXPECT_EQ(shrunk.Genus(), 0);
+  EXPECT_NEAR(shrunk.Volume(), 1, 0.02);
+
+  const Manifold shell = cube.Shell(r, 0.05);
+  EXPECT_EQ(shell.Genus(), -1);
+  EXPECT_NEAR(shell.Volume(), 7, 0.02);
+  EXPECT_TRUE(cube.Shell(0, 0.05).IsEmpty());
+}
@@ -17,7 +17,7 @@
 #include "manifold/polygon.h"
 #include "test.h"
 
-#if (MANIFOLD_PAR == 1)
+#if (MANIFOLD_PAR == 1) && !defined(MANIFOLD_PAR_NATIVE)
 #include <oneapi/tbb/parallel_for.h>
 #endif
 
@@ -53,7 +53,8 @@ int main(int argc, char** argv) {
 
   // warmup tbb for emscripten, according to
   // https://github.com/oneapi-src/oneTBB/blob/master/WASM_Support.md#limitations
-#if defined(__EMSCRIPTEN__) && (MANIFOLD_PAR == 1)
+#if defined(__EMSCRIPTEN__) && (MANIFOLD_PAR == 1) && \
+    !defined(MANIFOLD_PAR_NATIVE)
   int num_threads = tbb::this_task_arena::max_concurrency();
   std::atomic<int> barrier{num_threads};
   tbb::parallel_for(